@@ -0,0 +1,159 @@
+# MIT License
+#
+# Copyright(c) 2022-2024 Matthieu Bucchianeri
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this softwareand associated documentation files(the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions :
+#
+# The above copyright noticeand this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+# Rebuild the frame timeline from a file recorded with the record_frame_timeline setting (OpenXR-Timeline.bin), then
+# print statistics and pacing anomalies.
+#
+# Usage: python Analyze-FrameTimeline.py [--dump] <OpenXR-Timeline.bin>
+
+import statistics
+import struct
+import sys
+
+# Must match timeline_recorder.h.
+MAGIC = b'VDXRTL\0\0'
+VERSION = 1
+HEADER = struct.Struct('<8sIIq')
+RECORD = struct.Struct('<qqQIIHHI')
+
+EVENTS = {1: 'WaitFrame', 2: 'BeginFrame', 3: 'EndFrame', 4: 'SyncActions', 5: 'LocateSpace', 6: 'ReleaseSwapchainImage'}
+
+# A frame interval this much longer than the median is reported as a stutter.
+STUTTER_RATIO = 1.5
+
+def readTimeline(path):
+    with open(path, 'rb') as file:
+        data = file.read()
+
+    magic, version, recordSize, frequency = HEADER.unpack_from(data, 0)
+    if magic != MAGIC:
+        raise Exception('Not a frame timeline file')
+    if version != VERSION or recordSize != RECORD.size:
+        raise Exception(f'Unsupported frame timeline version {version}')
+
+    records = []
+    offset = HEADER.size
+    while offset + RECORD.size <= len(data):
+        start, end, arg0, arg1, threadId, event, result, _ = RECORD.unpack_from(data, offset)
+        records.append({'start': start / frequency, 'end': end / frequency, 'arg0': arg0, 'arg1': arg1,
+                        'thread': threadId, 'event': EVENTS.get(event, f'Unknown{event}'), 'failed': result != 0})
+        offset += RECORD.size
+
+    records.sort(key=lambda r: r['start'])
+    return records
+
+def buildFrames(records):
+    """Group the calls into frames, each frame starting with a successful xrWaitFrame()."""
+    frames = []
+    frame = None
+    for record in records:
+        if record['event'] == 'WaitFrame' and not record['failed']:
+            frame = {'id': record['arg1'], 'wait': record, 'begin': None, 'end': None, 'syncs': 0, 'locates': 0,
+                     'releases': 0, 'failures': 0}
+            frames.append(frame)
+            continue
+        if frame is None:
+            continue
+
+        if record['failed']:
+            frame['failures'] += 1
+        elif record['event'] == 'BeginFrame':
+            frame['begin'] = record
+        elif record['event'] == 'EndFrame':
+            frame['end'] = record
+        elif record['event'] == 'SyncActions':
+            frame['syncs'] += 1
+        elif record['event'] == 'LocateSpace':
+            frame['locates'] += 1
+        elif record['event'] == 'ReleaseSwapchainImage':
+            frame['releases'] += 1
+
+    return frames
+
+def percentile(values, p):
+    values = sorted(values)
+    return values[min(int(p * len(values)), len(values) - 1)] if values else 0.0
+
+def printStatistics(name, values):
+    if not values:
+        return
+    print(f'{name:<24} mean {statistics.mean(values) * 1e3:7.2f}ms  p50 {percentile(values, 0.5) * 1e3:7.2f}ms  '
+          f'p95 {percentile(values, 0.95) * 1e3:7.2f}ms  p99 {percentile(values, 0.99) * 1e3:7.2f}ms  '
+          f'max {max(values) * 1e3:7.2f}ms')
+
+def analyze(records, dump):
+    if dump:
+        origin = records[0]['start'] if records else 0
+        for record in records:
+            print(f"{(record['start'] - origin) * 1e3:12.3f}ms {(record['end'] - record['start']) * 1e3:8.3f}ms "
+                  f"thread {record['thread']:<6} {record['event']:<22} {record['arg0']:>20} {record['arg1']:>10}"
+                  f"{' FAILED' if record['failed'] else ''}")
+        print()
+
+    frames = buildFrames(records)
+    if len(frames) < 2:
+        print('Not enough frames recorded')
+        return
+
+    intervals = [b['wait']['end'] - a['wait']['end'] for (a, b) in zip(frames, frames[1:])]
+    waitTimes = [f['wait']['end'] - f['wait']['start'] for f in frames]
+    appTimes = [f['end']['start'] - f['wait']['end'] for f in frames if f['end']]
+    endTimes = [f['end']['end'] - f['end']['start'] for f in frames if f['end']]
+    medianInterval = statistics.median(intervals)
+
+    print(f'{len(frames)} frames over {frames[-1]["wait"]["end"] - frames[0]["wait"]["end"]:.2f}s, '
+          f'{1 / medianInterval:.1f} fps (median)')
+    printStatistics('Frame interval', intervals)
+    printStatistics('xrWaitFrame() blocked', waitTimes)
+    printStatistics('Wait to xrEndFrame()', appTimes)
+    printStatistics('xrEndFrame() duration', endTimes)
+    print(f'xrSyncActions() per frame: {statistics.mean(f["syncs"] for f in frames):.1f}, '
+          f'xrLocateSpace() per frame: {statistics.mean(f["locates"] for f in frames):.1f}')
+    print()
+
+    anomalies = 0
+    for (previous, frame) in zip(frames, frames[1:]):
+        interval = frame['wait']['end'] - previous['wait']['end']
+        if interval > medianInterval * STUTTER_RATIO:
+            print(f'Frame {frame["id"]}: stutter, {interval * 1e3:.2f}ms since the previous frame')
+            anomalies += 1
+    for frame in frames:
+        if frame['end'] is None:
+            print(f'Frame {frame["id"]}: never submitted')
+            anomalies += 1
+        elif frame['begin'] and frame['begin']['arg1']:
+            print(f'Frame {frame["id"]}: previous frame discarded')
+            anomalies += 1
+        if frame['failures']:
+            print(f'Frame {frame["id"]}: {frame["failures"]} failed call(s)')
+            anomalies += 1
+    print(f'{anomalies} anomalies')
+
+if __name__ == '__main__':
+    args = sys.argv[1:]
+    dump = '--dump' in args
+    args = [arg for arg in args if arg != '--dump']
+    if len(args) != 1:
+        print(f'Usage: {sys.argv[0]} [--dump] <OpenXR-Timeline.bin>')
+        sys.exit(1)
+
+    analyze(readTimeline(args[0]), dump)
@@ -0,0 +1,270 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "body_state_history.h"
+
+namespace {
+
+    using namespace virtualdesktop_openxr;
+    using namespace virtualdesktop_openxr::utils;
+
+    constexpr float k_tolerance = 1e-4f;
+
+    BodyTracking::BodyStateV2 MakeState(int32_t tag) {
+        BodyTracking::BodyStateV2 state{};
+        state.SkeletonChangedCount = tag;
+        return state;
+    }
+
+    void MakeIdentity(BodyTracking::Pose& pose, float x) {
+        pose.orientation = {0.f, 0.f, 0.f, 1.f};
+        pose.position = {x, 0.f, 0.f};
+    }
+
+    TEST_CLASS(BodyStateHistoryTests) {
+      public:
+        TEST_METHOD(Empty) {
+            const auto history = std::make_unique<BodyStateHistory>();
+            BodyTracking::BodyStateV2 state{};
+            Assert::IsFalse(history->latest(state));
+            Assert::IsFalse(history->newestTime().has_value());
+            Assert::IsFalse(history->sample(0.0, {}, state));
+        }
+
+        TEST_METHOD(RingWrapAround) {
+            const auto history = std::make_unique<BodyStateHistory>();
+            constexpr int32_t count = 3 * BodyStateHistory::k_capacity + 4;
+            for (int32_t i = 0; i < count; i++) {
+                history->push(i * 0.01, MakeState(i));
+            }
+
+            BodyTracking::BodyStateV2 state{};
+            Assert::IsTrue(history->latest(state));
+            Assert::AreEqual(count - 1, state.SkeletonChangedCount);
+            Assert::AreEqual((count - 1) * 0.01, history->newestTime().value(), 1e-9);
+
+            // Samples within the ring are found exactly.
+            const int32_t recent = count - 3;
+            Assert::IsTrue(history->sample(recent * 0.01, {}, state));
+            Assert::AreEqual(recent, state.SkeletonChangedCount);
+
+            // Samples that were overwritten resolve to the oldest one left (the ring keeps one slot of slack).
+            const int32_t oldest = count - (int32_t)(BodyStateHistory::k_capacity - 1);
+            Assert::IsTrue(history->sample(0.0, {}, state));
+            Assert::AreEqual(oldest, state.SkeletonChangedCount);
+        }
+
+        TEST_METHOD(InterpolateBetweenSamples) {
+            const auto history = std::make_unique<BodyStateHistory>();
+            BodyTracking::BodyStateV2 a = MakeState(1);
+            BodyTracking::BodyStateV2 b = MakeState(2);
+            a.FaceIsValid = b.FaceIsValid = true;
+            a.ExpressionWeights[0] = 0.f;
+            b.ExpressionWeights[0] = 1.f;
+            a.BodyTrackingConfidence = 0.5f;
+            b.BodyTrackingConfidence = 1.f;
+            a.BodyJoints[0].LocationFlags = b.BodyJoints[0].LocationFlags =
+                XR_SPACE_LOCATION_ORIENTATION_VALID_BIT | XR_SPACE_LOCATION_POSITION_VALID_BIT;
+            MakeIdentity(a.BodyJoints[0].Pose, 0.f);
+            MakeIdentity(b.BodyJoints[0].Pose, 2.f);
+            history->push(1.0, a);
+            history->push(2.0, b);
+
+            BodyTracking::BodyStateV2 state{};
+            Assert::IsTrue(history->sample(1.25, {}, state));
+            Assert::AreEqual(0.25f, state.ExpressionWeights[0], k_tolerance);
+            Assert::AreEqual(0.625f, state.BodyTrackingConfidence, k_tolerance);
+            Assert::AreEqual(0.5f, state.BodyJoints[0].Pose.position.x, k_tolerance);
+            Assert::AreEqual(1.f, state.BodyJoints[0].Pose.orientation.w, k_tolerance);
+
+            // Discrete data comes from the nearest sample.
+            Assert::AreEqual(1, state.SkeletonChangedCount);
+            Assert::IsTrue(history->sample(1.75, {}, state));
+            Assert::AreEqual(2, state.SkeletonChangedCount);
+        }
+
+        TEST_METHOD(ExtrapolateWithinLimits) {
+            const auto history = std::make_unique<BodyStateHistory>();
+            BodyTracking::BodyStateV2 a = MakeState(1);
+            BodyTracking::BodyStateV2 b = MakeState(2);
+            a.LeftHandActive = b.LeftHandActive = true;
+            MakeIdentity(a.LeftHandJointStates[0].Pose, 0.f);
+            MakeIdentity(b.LeftHandJointStates[0].Pose, 1.f);
+            b.LeftHandJointStates[0].LinearVelocity = {1.f, 0.f, 0.f};
+            a.FaceIsValid = b.FaceIsValid = true;
+            a.ExpressionWeights[0] = 0.5f;
+            b.ExpressionWeights[0] = 1.f;
+            a.ExpressionConfidences[0] = 0.f;
+            b.ExpressionConfidences[0] = 1.f;
+            history->push(1.0, a);
+            history->push(2.0, b);
+
+            BodyStateHistory::PredictionLimits limits;
+            limits.joints = 0.05;
+            limits.face = 10.0;
+
+            // Hand joints follow their reported velocity, up to the prediction limit.
+            BodyTracking::BodyStateV2 state{};
+            Assert::IsTrue(history->sample(2.5, limits, state));
+            Assert::AreEqual(1.05f, state.LeftHandJointStates[0].Pose.position.x, k_tolerance);
+
+            // Expression weights are clamped to their valid range, and confidences are not extrapolated.
+            Assert::AreEqual(1.f, state.ExpressionWeights[0], k_tolerance);
+            Assert::AreEqual(1.f, state.ExpressionConfidences[0], k_tolerance);
+            Assert::AreEqual(2, state.SkeletonChangedCount);
+        }
+
+        TEST_METHOD(HoldWithoutPrediction) {
+            const auto history = std::make_unique<BodyStateHistory>();
+            BodyTracking::BodyStateV2 a = MakeState(1);
+            BodyTracking::BodyStateV2 b = MakeState(2);
+            a.LeftHandActive = b.LeftHandActive = true;
+            MakeIdentity(a.LeftHandJointStates[0].Pose, 0.f);
+            MakeIdentity(b.LeftHandJointStates[0].Pose, 1.f);
+            b.LeftHandJointStates[0].LinearVelocity = {1.f, 0.f, 0.f};
+            history->push(1.0, a);
+            history->push(2.0, b);
+
+            BodyStateHistory::PredictionLimits limits;
+            limits.joints = limits.eyes = limits.face = 0.0;
+
+            BodyTracking::BodyStateV2 state{};
+            Assert::IsTrue(history->sample(3.0, limits, state));
+            Assert::AreEqual(2, state.SkeletonChangedCount);
+            Assert::AreEqual(1.f, state.LeftHandJointStates[0].Pose.position.x, k_tolerance);
+        }
+
+        TEST_METHOD(PredictionModes) {
+            const auto history = std::make_unique<BodyStateHistory>();
+            BodyTracking::BodyStateV2 a = MakeState(1);
+            BodyTracking::BodyStateV2 b = MakeState(2);
+            a.LeftHandActive = b.LeftHandActive = true;
+            MakeIdentity(a.LeftHandJointStates[0].Pose, 0.f);
+            MakeIdentity(b.LeftHandJointStates[0].Pose, 1.f);
+            b.LeftHandJointStates[0].LinearVelocity = {1.f, 0.f, 0.f};
+            history->push(1.0, a);
+            history->push(2.0, b);
+
+            BodyStateHistory::PredictionLimits limits;
+            limits.joints = 0.05;
+
+            // Hold never blends: it returns the sample preceding the requested time.
+            limits.mode = BodyStateHistory::PredictionMode::Hold;
+            BodyTracking::BodyStateV2 state{};
+            Assert::IsTrue(history->sample(1.75, limits, state));
+            Assert::AreEqual(1, state.SkeletonChangedCount);
+            Assert::AreEqual(0.f, state.LeftHandJointStates[0].Pose.position.x, k_tolerance);
+            Assert::IsTrue(history->sample(2.5, limits, state));
+            Assert::AreEqual(1.f, state.LeftHandJointStates[0].Pose.position.x, k_tolerance);
+            Assert::AreEqual(0.0, BodyStateHistory::maxPredictionFor(limits));
+
+            // Interpolate blends between samples, but stops at the most recent one.
+            limits.mode = BodyStateHistory::PredictionMode::Interpolate;
+            Assert::IsTrue(history->sample(1.75, limits, state));
+            Assert::AreEqual(0.75f, state.LeftHandJointStates[0].Pose.position.x, k_tolerance);
+            Assert::IsTrue(history->sample(2.5, limits, state));
+            Assert::AreEqual(1.f, state.LeftHandJointStates[0].Pose.position.x, k_tolerance);
+            Assert::AreEqual(0.0, BodyStateHistory::maxPredictionFor(limits));
+
+            // Extrapolate goes past the most recent sample, within the prediction limit.
+            limits.mode = BodyStateHistory::PredictionMode::Extrapolate;
+            Assert::IsTrue(history->sample(1.75, limits, state));
+            Assert::AreEqual(0.75f, state.LeftHandJointStates[0].Pose.position.x, k_tolerance);
+            Assert::IsTrue(history->sample(2.5, limits, state));
+            Assert::AreEqual(1.05f, state.LeftHandJointStates[0].Pose.position.x, k_tolerance);
+            Assert::AreEqual(0.05, BodyStateHistory::maxPredictionFor(limits));
+        }
+
+        // Replay a steadily moving hand and compare the prediction error of each mode at typical horizons.
+        TEST_METHOD(PredictionErrorAtHorizons) {
+            constexpr double period = 0.011;
+            constexpr float speed = 0.5f;
+            const auto history = std::make_unique<BodyStateHistory>();
+            for (int32_t i = 0; i < 10; i++) {
+                BodyTracking::BodyStateV2 state = MakeState(i);
+                state.LeftHandActive = true;
+                MakeIdentity(state.LeftHandJointStates[0].Pose, (float)(speed * i * period));
+                state.LeftHandJointStates[0].LinearVelocity = {speed, 0.f, 0.f};
+                history->push(i * period, state);
+            }
+            const double newest = history->newestTime().value();
+
+            BodyStateHistory::PredictionLimits limits;
+            limits.joints = 0.05;
+            const auto errorAt = [&](BodyStateHistory::PredictionMode mode, double horizon) {
+                limits.mode = mode;
+                BodyTracking::BodyStateV2 state{};
+                Assert::IsTrue(history->sample(newest + horizon, limits, state));
+                return std::abs(state.LeftHandJointStates[0].Pose.position.x - (float)(speed * (newest + horizon)));
+            };
+
+            for (const double horizon : {0.01, 0.02, 0.04}) {
+                const float holdError = errorAt(BodyStateHistory::PredictionMode::Hold, horizon);
+                const float interpolateError = errorAt(BodyStateHistory::PredictionMode::Interpolate, horizon);
+                const float extrapolateError = errorAt(BodyStateHistory::PredictionMode::Extrapolate, horizon);
+                Logger::WriteMessage(fmt::format("{:.0f}ms: hold={:.4f} interpolate={:.4f} extrapolate={:.4f}\n",
+                                                 horizon * 1000,
+                                                 holdError,
+                                                 interpolateError,
+                                                 extrapolateError)
+                                         .c_str());
+
+                Assert::AreEqual(speed * (float)horizon, holdError, k_tolerance);
+                Assert::AreEqual(holdError, interpolateError, k_tolerance);
+                Assert::AreEqual(0.f, extrapolateError, k_tolerance);
+            }
+        }
+
+        TEST_METHOD(ConcurrentReadsAreNotTorn) {
+            const auto history = std::make_unique<BodyStateHistory>();
+            constexpr int32_t count = 20000;
+
+            std::thread writer([&] {
+                for (int32_t i = 1; i <= count; i++) {
+                    BodyTracking::BodyStateV2 state = MakeState(i);
+                    std::fill(std::begin(state.ExpressionWeights), std::end(state.ExpressionWeights), (float)i);
+                    history->push(i * 0.001, state);
+                }
+            });
+
+            bool isTorn = false;
+            int32_t last = 0;
+            BodyTracking::BodyStateV2 state{};
+            while (last < count) {
+                if (!history->latest(state)) {
+                    continue;
+                }
+                for (const float weight : state.ExpressionWeights) {
+                    isTorn = isTorn || weight != (float)state.SkeletonChangedCount;
+                }
+                isTorn = isTorn || state.SkeletonChangedCount < last;
+                last = state.SkeletonChangedCount;
+            }
+            writer.join();
+
+            Assert::IsFalse(isTorn);
+        }
+    };
+
+} // namespace
@@ -0,0 +1,142 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "frame_simulator.h"
+
+namespace {
+
+    using namespace virtualdesktop_openxr;
+    using namespace virtualdesktop_openxr::test;
+
+    constexpr double k_refreshPeriod = 1.0 / 90;
+
+    // The fault injector between the frame loop validator and the simulated compositor, as set up by the runtime.
+    struct Fixture {
+        Fixture(uint32_t faults) {
+            auto mock = std::make_unique<MockFrameCompositor>(clock, k_refreshPeriod, 0.002, 0.0, 0);
+            compositor = mock.get();
+            auto injector = std::make_unique<FaultInjectingFrameCompositor>(
+                std::move(mock), faults, k_refreshPeriod, [&](double duration) { clock.advance(duration); });
+            validator = std::make_unique<FrameLoopValidator>(std::move(injector));
+            simulator = std::make_unique<FrameLoopSimulator>(clock, *validator);
+        }
+
+        // Continue the frame loop for a number of frames.
+        LatencyReport run(uint32_t frameCount) {
+            FrameLoopSimulator::Options options;
+            options.frameCount = frameCount;
+            options.appTime = 0.005;
+            simulator->run(options);
+            return compositor->getReport();
+        }
+
+        ovrPerfStats getPerfStats() {
+            ovrPerfStats stats{};
+            Assert::IsTrue(OVR_SUCCESS(validator->getPerfStats(stats)));
+            Assert::IsTrue(stats.FrameStatsCount > 0);
+            return stats;
+        }
+
+        VirtualClock clock;
+        MockFrameCompositor* compositor;
+        std::unique_ptr<FrameLoopValidator> validator;
+        std::unique_ptr<FrameLoopSimulator> simulator;
+    };
+
+    TEST_CLASS(CompositorFaultTests) {
+      public:
+        TEST_METHOD(NoFaults) {
+            Fixture fixture(0);
+            const LatencyReport report = fixture.run(1000);
+            const ovrPerfStats stats = fixture.getPerfStats();
+
+            Assert::AreEqual(0u, fixture.validator->getViolationCount());
+            Assert::AreEqual(0u, report.framesMissed);
+            Assert::IsFalse(!!stats.AswIsAvailable);
+            Assert::IsFalse(!!stats.FrameStats[0].AswIsActive);
+            Assert::AreEqual(0, stats.FrameStats[0].AppDroppedFrameCount);
+        }
+
+        TEST_METHOD(AswEngaged) {
+            Fixture fixture(FaultInjectingFrameCompositor::AswEngaged);
+            for (int i = 0; i < 3; i++) {
+                fixture.run(100);
+                const ovrPerfStats stats = fixture.getPerfStats();
+                Assert::IsTrue(!!stats.AswIsAvailable);
+                Assert::IsTrue(!!stats.FrameStats[0].AswIsActive);
+            }
+        }
+
+        TEST_METHOD(AswToggling) {
+            Fixture fixture(FaultInjectingFrameCompositor::AswToggling);
+
+            // Frames 0-299 have ASW disengaged, frames 300-599 have it engaged.
+            fixture.run(300);
+            Assert::IsFalse(!!fixture.getPerfStats().FrameStats[0].AswIsActive);
+            fixture.run(300);
+            Assert::IsTrue(!!fixture.getPerfStats().FrameStats[0].AswIsActive);
+            fixture.run(300);
+            Assert::IsFalse(!!fixture.getPerfStats().FrameStats[0].AswIsActive);
+            Assert::AreEqual(0u, fixture.validator->getViolationCount());
+        }
+
+        TEST_METHOD(DroppedFrames) {
+            Fixture fixture(FaultInjectingFrameCompositor::DroppedFrames);
+
+            // Frames 0, 97, ..., 873 are delayed by a refresh period, which makes each of them miss its vsync.
+            const LatencyReport report = fixture.run(970);
+            const ovrPerfStats stats = fixture.getPerfStats();
+
+            Assert::AreEqual(0u, fixture.validator->getViolationCount());
+            Assert::AreEqual(10u, report.framesMissed);
+            Assert::AreEqual(970u, report.framesDisplayed);
+            Assert::IsTrue(report.latencyP99 > report.latencyP50);
+
+            // The mock reports its missed frames, and the injector adds the frames it dropped.
+            Assert::AreEqual(20, stats.FrameStats[0].AppDroppedFrameCount);
+        }
+
+        TEST_METHOD(CompositorSpikes) {
+            Fixture fixture(FaultInjectingFrameCompositor::CompositorSpikes);
+
+            // The spike is reported while the most recently waited frame is a multiple of 50.
+            fixture.run(101);
+            Assert::AreEqual((float)(k_refreshPeriod * 0.8),
+                             fixture.getPerfStats().FrameStats[0].CompositorCpuStartToGpuEndElapsedTime,
+                             1e-6f);
+            fixture.run(1);
+            Assert::AreEqual(0.002f, fixture.getPerfStats().FrameStats[0].CompositorCpuStartToGpuEndElapsedTime, 1e-6f);
+        }
+
+        TEST_METHOD(AllFaultsKeepFrameLoopValid) {
+            Fixture fixture(FaultInjectingFrameCompositor::AswToggling | FaultInjectingFrameCompositor::DroppedFrames |
+                            FaultInjectingFrameCompositor::CompositorSpikes);
+            const LatencyReport report = fixture.run(3000);
+
+            Assert::AreEqual(0u, fixture.validator->getViolationCount());
+            Assert::AreEqual(3000u, report.framesDisplayed);
+        }
+    };
+
+} // namespace
@@ -0,0 +1,151 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "frame_simulator.h"
+
+namespace {
+
+    using namespace virtualdesktop_openxr;
+    using namespace virtualdesktop_openxr::test;
+
+    constexpr double k_refreshPeriod = 1.0 / 90;
+
+    struct Fixture {
+        Fixture(double compositorTime, double compositorJitter = 0.0, int seed = 0) {
+            auto mock =
+                std::make_unique<MockFrameCompositor>(clock, k_refreshPeriod, compositorTime, compositorJitter, seed);
+            compositor = mock.get();
+            validator = std::make_unique<FrameLoopValidator>(std::move(mock));
+        }
+
+        LatencyReport run(const FrameLoopSimulator::Options& options) {
+            FrameLoopSimulator simulator(clock, *validator);
+            simulator.run(options);
+            return compositor->getReport();
+        }
+
+        VirtualClock clock;
+        MockFrameCompositor* compositor;
+        std::unique_ptr<FrameLoopValidator> validator;
+    };
+
+    TEST_CLASS(FrameLoopTests) {
+      public:
+        TEST_METHOD(SteadyState) {
+            Fixture fixture(0.002);
+            FrameLoopSimulator::Options options;
+            options.appTime = 0.005;
+            const LatencyReport report = fixture.run(options);
+
+            Assert::AreEqual(0u, fixture.validator->getViolationCount());
+            Assert::AreEqual(options.frameCount, report.framesDisplayed);
+            Assert::AreEqual(0u, report.framesMissed);
+            Assert::AreEqual(k_refreshPeriod, report.latencyP50, 1e-6);
+            Assert::AreEqual(k_refreshPeriod, report.latencyP99, 1e-6);
+            Assert::AreEqual(90.0, report.throughput, 0.01);
+        }
+
+        TEST_METHOD(SlowApplicationHalvesFrameRate) {
+            Fixture fixture(0.002);
+            FrameLoopSimulator::Options options;
+            options.appTime = 0.010;
+            const LatencyReport report = fixture.run(options);
+
+            // Every frame misses its vsync and is displayed one refresh period late.
+            Assert::AreEqual(0u, fixture.validator->getViolationCount());
+            Assert::AreEqual(options.frameCount, report.framesMissed);
+            Assert::AreEqual(2 * k_refreshPeriod, report.latencyP50, 1e-6);
+            Assert::AreEqual(45.0, report.throughput, 0.01);
+        }
+
+        TEST_METHOD(JitterIsDeterministic) {
+            FrameLoopSimulator::Options options;
+            options.frameCount = 5000;
+            options.appTime = 0.004;
+            options.appJitter = 0.006;
+            options.seed = 42;
+
+            Fixture first(0.002, 0.001, 7);
+            const LatencyReport report = first.run(options);
+            Assert::AreEqual(0u, first.validator->getViolationCount());
+            Assert::AreEqual(options.frameCount, report.framesDisplayed);
+            Assert::IsTrue(report.framesMissed > 0 && report.framesMissed < options.frameCount);
+            Assert::IsTrue(report.latencyP99 > report.latencyP50);
+            Assert::IsTrue(report.throughput > 45.0 && report.throughput < 90.0);
+
+            Fixture second(0.002, 0.001, 7);
+            const LatencyReport replay = second.run(options);
+            Assert::AreEqual(report.framesMissed, replay.framesMissed);
+            Assert::AreEqual(report.latencyP99, replay.latencyP99);
+        }
+
+        TEST_METHOD(DiscardedFrames) {
+            Fixture fixture(0.002);
+            FrameLoopSimulator::Options options;
+            options.discardPeriod = 10;
+            const LatencyReport report = fixture.run(options);
+
+            Assert::AreEqual(0u, fixture.validator->getViolationCount());
+            Assert::AreEqual(options.frameCount / 10, report.framesDiscarded);
+            Assert::AreEqual(options.frameCount - report.framesDiscarded, report.framesDisplayed);
+        }
+
+        TEST_METHOD(ValidatorReportsViolations) {
+            Fixture fixture(0.002);
+            FrameLoopValidator& validator = *fixture.validator;
+
+            // Begun twice.
+            validator.waitToBeginFrame(0);
+            validator.beginFrame(0);
+            validator.beginFrame(0);
+            const uint32_t doubleBegin = validator.getViolationCount();
+            Assert::IsTrue(doubleBegin > 0);
+
+            // Begun without being waited.
+            validator.beginFrame(5);
+            const uint32_t notWaited = validator.getViolationCount();
+            Assert::IsTrue(notWaited > doubleBegin);
+
+            // Lost (begun, then superseded without being ended or discarded).
+            validator.waitToBeginFrame(6);
+            validator.beginFrame(6);
+            Assert::IsTrue(validator.getViolationCount() > notWaited);
+        }
+
+        TEST_METHOD(ValidatorReportsDisplayTimeRegression) {
+            Fixture fixture(0.002);
+            FrameLoopValidator& validator = *fixture.validator;
+
+            validator.checkPredictedDisplayTime(0, 2'000'000'000);
+            validator.checkPredictedDisplayTime(1, 2'011'111'111);
+            Assert::AreEqual(0u, validator.getViolationCount());
+
+            validator.checkPredictedDisplayTime(2, 2'011'111'111);
+            Assert::AreEqual(1u, validator.getViolationCount());
+            validator.checkPredictedDisplayTime(3, 2'000'000'000);
+            Assert::AreEqual(2u, validator.getViolationCount());
+        }
+    };
+
+} // namespace
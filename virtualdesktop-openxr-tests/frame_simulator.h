@@ -0,0 +1,237 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "pch.h"
+
+#include "frame_compositor.h"
+
+namespace virtualdesktop_openxr::test {
+
+    // A clock that only moves when told to, so that a frame loop plays the same way on every run.
+    class VirtualClock {
+      public:
+        double now() const {
+            return m_now;
+        }
+
+        void advance(double duration) {
+            m_now += std::max(duration, 0.0);
+        }
+
+        void advanceTo(double time) {
+            m_now = std::max(m_now, time);
+        }
+
+      private:
+        double m_now{1.0};
+    };
+
+    // Latency and throughput of a simulated frame loop.
+    struct LatencyReport {
+        uint32_t framesDisplayed{0};
+        uint32_t framesMissed{0};
+        uint32_t framesDiscarded{0};
+        // From the beginning of a frame to its display, in seconds.
+        double latencyP50{0.0};
+        double latencyP99{0.0};
+        // Displayed frames per second of simulated time.
+        double throughput{0.0};
+    };
+
+    // A compositor with a fixed refresh rate, driven by a virtual clock. A frame is waited until one refresh period
+    // before its display time, and it misses its display time if the compositor cannot finish it before the vsync.
+    class MockFrameCompositor : public IFrameCompositor {
+      public:
+        MockFrameCompositor(VirtualClock& clock, double refreshPeriod, double compositorTime, double jitter, int seed)
+            : m_clock(clock), m_refreshPeriod(refreshPeriod), m_compositorTime(compositorTime), m_jitter(jitter),
+              m_random(seed) {
+        }
+
+        ovrResult waitToBeginFrame(long long frameId) override {
+            // Let the application start one refresh period ahead of the next display time. When running late, target
+            // the first vsync that still leaves a refresh period to render.
+            double displayTime = std::max(m_lastPredictedDisplayTime, m_lastDisplayTime) + m_refreshPeriod;
+            if (m_clock.now() > displayTime - m_refreshPeriod) {
+                displayTime = nextVsync(m_clock.now() + m_refreshPeriod);
+            }
+            m_clock.advanceTo(displayTime - m_refreshPeriod);
+
+            m_frames[frameId] = {displayTime};
+            m_lastPredictedDisplayTime = displayTime;
+            return ovrSuccess;
+        }
+
+        ovrResult beginFrame(long long frameId) override {
+            const auto it = m_frames.find(frameId);
+            if (it == m_frames.end()) {
+                return ovrError_InvalidOperation;
+            }
+            it->second.beginTime = m_clock.now();
+            return ovrSuccess;
+        }
+
+        void discardFrame(long long frameId) override {
+            m_frames.erase(frameId);
+            m_framesDiscarded++;
+        }
+
+        ovrResult endFrame(long long frameId,
+                           const ovrViewScaleDesc* viewScaleDesc,
+                           ovrLayerHeader const* const* layers,
+                           unsigned int layerCount) override {
+            const auto it = m_frames.find(frameId);
+            if (it == m_frames.end() || !it->second.beginTime) {
+                return ovrError_InvalidOperation;
+            }
+
+            // The compositor needs time to process the frame, and the frame is only displayed at the next vsync.
+            const double compositorTime = m_compositorTime + m_jitter * m_distribution(m_random);
+            m_lastCompositorTime = compositorTime;
+            const double readyTime = m_clock.now() + compositorTime;
+            double displayTime = it->second.displayTime;
+            if (readyTime > displayTime) {
+                displayTime = nextVsync(readyTime);
+                m_framesMissed++;
+            }
+
+            m_latencies.push_back(displayTime - it->second.beginTime.value());
+            m_firstDisplayTime = std::min(m_firstDisplayTime, displayTime);
+            m_lastDisplayTime = std::max(m_lastDisplayTime, displayTime);
+            m_framesDisplayed++;
+
+            m_frames.erase(it);
+            return ovrSuccess;
+        }
+
+        double getPredictedDisplayTime(long long frameId) override {
+            const auto it = m_frames.find(frameId);
+            return it != m_frames.end() ? it->second.displayTime : m_lastPredictedDisplayTime;
+        }
+
+        ovrResult getPerfStats(ovrPerfStats& stats) override {
+            stats = {};
+            stats.FrameStatsCount = 1;
+            stats.FrameStats[0].AppFrameIndex = (int)m_framesDisplayed;
+            stats.FrameStats[0].AppDroppedFrameCount = (int)m_framesMissed;
+            stats.FrameStats[0].CompositorCpuStartToGpuEndElapsedTime = (float)m_lastCompositorTime;
+            return ovrSuccess;
+        }
+
+        LatencyReport getReport() const {
+            LatencyReport report;
+            report.framesDisplayed = m_framesDisplayed;
+            report.framesMissed = m_framesMissed;
+            report.framesDiscarded = m_framesDiscarded;
+
+            if (!m_latencies.empty()) {
+                std::vector<double> latencies = m_latencies;
+                std::sort(latencies.begin(), latencies.end());
+                const auto percentile = [&](double p) {
+                    return latencies[std::min((size_t)(p * latencies.size()), latencies.size() - 1)];
+                };
+                report.latencyP50 = percentile(0.5);
+                report.latencyP99 = percentile(0.99);
+            }
+            if (m_framesDisplayed > 1) {
+                report.throughput = (m_framesDisplayed - 1) / (m_lastDisplayTime - m_firstDisplayTime);
+            }
+
+            return report;
+        }
+
+      private:
+        struct Frame {
+            double displayTime;
+            std::optional<double> beginTime;
+        };
+
+        // The first vsync at or after the given time.
+        double nextVsync(double time) const {
+            return std::ceil(time / m_refreshPeriod) * m_refreshPeriod;
+        }
+
+        VirtualClock& m_clock;
+        const double m_refreshPeriod;
+        const double m_compositorTime;
+        const double m_jitter;
+        std::mt19937 m_random;
+        std::uniform_real_distribution<double> m_distribution{0.0, 1.0};
+
+        std::map<long long, Frame> m_frames;
+        double m_lastPredictedDisplayTime{0.0};
+        double m_lastDisplayTime{0.0};
+        double m_firstDisplayTime{DBL_MAX};
+        double m_lastCompositorTime{0.0};
+        uint32_t m_framesDisplayed{0};
+        uint32_t m_framesMissed{0};
+        uint32_t m_framesDiscarded{0};
+        std::vector<double> m_latencies;
+    };
+
+    // Play the application side of the frame loop (wait, begin, render, end) against a compositor, the same way
+    // xrWaitFrame(), xrBeginFrame() and xrEndFrame() drive it for a synchronous submission.
+    class FrameLoopSimulator {
+      public:
+        struct Options {
+            uint32_t frameCount{1000};
+            // The time the application spends rendering a frame, plus a random amount of up to the jitter.
+            double appTime{0.005};
+            double appJitter{0.0};
+            // Discard (begin without ending) one frame every so many frames. 0 never discards.
+            uint32_t discardPeriod{0};
+            int seed{0};
+        };
+
+        FrameLoopSimulator(VirtualClock& clock, FrameLoopValidator& compositor)
+            : m_clock(clock), m_compositor(compositor) {
+        }
+
+        void run(const Options& options) {
+            std::mt19937 random(options.seed);
+            std::uniform_real_distribution<double> distribution(0.0, 1.0);
+
+            for (uint32_t i = 0; i < options.frameCount; i++) {
+                const long long frameId = m_nextFrameId++;
+                Assert::IsTrue(OVR_SUCCESS(m_compositor.waitToBeginFrame(frameId)));
+                const double predictedDisplayTime = m_compositor.getPredictedDisplayTime(frameId);
+                m_compositor.checkPredictedDisplayTime(frameId, (XrTime)(predictedDisplayTime * 1e9));
+
+                Assert::IsTrue(OVR_SUCCESS(m_compositor.beginFrame(frameId)));
+                m_clock.advance(options.appTime + options.appJitter * distribution(random));
+
+                if (options.discardPeriod && (i + 1) % options.discardPeriod == 0) {
+                    m_compositor.discardFrame(frameId);
+                    continue;
+                }
+                Assert::IsTrue(OVR_SUCCESS(m_compositor.endFrame(frameId, nullptr, nullptr, 0)));
+            }
+        }
+
+      private:
+        VirtualClock& m_clock;
+        FrameLoopValidator& m_compositor;
+        long long m_nextFrameId{0};
+    };
+
+} // namespace virtualdesktop_openxr::test
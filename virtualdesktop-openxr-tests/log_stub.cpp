@@ -0,0 +1,64 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "log.h"
+
+// The runtime headers under test may trace and log. Send the messages to the test output instead of the log file.
+namespace virtualdesktop_openxr::log {
+
+    // {7e1a3c2f-5b8d-4e6a-9c41-2f0d8b6a5e13}
+    TRACELOGGING_DEFINE_PROVIDER(g_traceProvider,
+                                 "VirtualDesktopOpenXRTests",
+                                 (0x7e1a3c2f, 0x5b8d, 0x4e6a, 0x9c, 0x41, 0x2f, 0x0d, 0x8b, 0x6a, 0x5e, 0x13));
+
+    namespace {
+        void WriteMessage(const char* fmt, va_list va) {
+            char buf[1024];
+            _vsnprintf_s(buf, sizeof(buf), _TRUNCATE, fmt, va);
+            Logger::WriteMessage(buf);
+        }
+    } // namespace
+
+    void Log(const char* fmt, ...) {
+        va_list va;
+        va_start(va, fmt);
+        WriteMessage(fmt, va);
+        va_end(va);
+    }
+
+    void DebugLog(const char* fmt, ...) {
+        va_list va;
+        va_start(va, fmt);
+        WriteMessage(fmt, va);
+        va_end(va);
+    }
+
+    void ErrorLog(const char* fmt, ...) {
+        va_list va;
+        va_start(va, fmt);
+        WriteMessage(fmt, va);
+        va_end(va);
+    }
+
+} // namespace virtualdesktop_openxr::log
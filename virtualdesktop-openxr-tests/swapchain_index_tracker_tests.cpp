@@ -0,0 +1,122 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "swapchain_index_tracker.h"
+
+namespace {
+
+    using namespace virtualdesktop_openxr::utils;
+
+    TEST_CLASS(SwapchainIndexTrackerTests) {
+      public:
+        TEST_METHOD(StartsUnsynchronized) {
+            SwapchainIndexTracker tracker;
+            Assert::IsFalse(tracker.isSynchronized());
+
+            tracker.synchronize(3, 1);
+            Assert::IsTrue(tracker.isSynchronized());
+            Assert::AreEqual(1, tracker.currentIndex());
+            Assert::AreEqual(0, tracker.committedIndex());
+            Assert::AreEqual(0, tracker.takePendingCommits());
+        }
+
+        TEST_METHOD(PresentNextImage) {
+            SwapchainIndexTracker tracker;
+            tracker.synchronize(3, 0);
+
+            // Presenting the current image takes a single commit, and wraps around the ring.
+            for (int i = 0; i < 7; i++) {
+                const int index = i % 3;
+                Assert::AreEqual(index, tracker.currentIndex());
+                Assert::AreEqual(1, tracker.present(index));
+                Assert::AreEqual(index, tracker.committedIndex());
+                Assert::AreEqual(1, tracker.takePendingCommits());
+            }
+        }
+
+        TEST_METHOD(PresentSkipsImages) {
+            SwapchainIndexTracker tracker;
+            tracker.synchronize(3, 0);
+
+            // Image 2 is two commits away.
+            Assert::AreEqual(2, tracker.commitsToPresent(1));
+            Assert::AreEqual(2, tracker.present(1));
+            Assert::AreEqual(2, tracker.currentIndex());
+
+            // Presenting the most recently committed image again takes no commit.
+            Assert::AreEqual(0, tracker.present(1));
+            Assert::AreEqual(2, tracker.currentIndex());
+
+            // Wrap around to image 0.
+            Assert::AreEqual(2, tracker.present(0));
+            Assert::AreEqual(1, tracker.currentIndex());
+
+            // Commits accumulate until they are issued.
+            Assert::AreEqual(4, tracker.takePendingCommits());
+            Assert::AreEqual(0, tracker.takePendingCommits());
+        }
+
+        TEST_METHOD(VerifyResynchronizes) {
+            SwapchainIndexTracker tracker;
+            tracker.synchronize(3, 0);
+            tracker.present(0);
+            tracker.takePendingCommits();
+
+            Assert::IsTrue(tracker.verify(1));
+            Assert::AreEqual(1, tracker.currentIndex());
+
+            // A commit that we did not account for.
+            Assert::IsFalse(tracker.verify(2));
+            Assert::IsTrue(tracker.isSynchronized());
+            Assert::AreEqual(2, tracker.currentIndex());
+            Assert::AreEqual(1, tracker.present(2));
+            Assert::AreEqual(0, tracker.currentIndex());
+        }
+
+        TEST_METHOD(InvalidateAfterFailedCommit) {
+            SwapchainIndexTracker tracker;
+            tracker.synchronize(3, 0);
+            Assert::AreEqual(2, tracker.present(1));
+
+            // The commits are taken, then issuing them fails part-way: the state of the ring is unknown.
+            Assert::AreEqual(2, tracker.takePendingCommits());
+            tracker.invalidate();
+            Assert::IsFalse(tracker.isSynchronized());
+
+            // Scheduled commits that were not taken yet are dropped too.
+            tracker.synchronize(3, 0);
+            tracker.present(2);
+            tracker.invalidate();
+            Assert::AreEqual(0, tracker.takePendingCommits());
+
+            // The next frame resynchronizes with the index reported by LibOVR.
+            tracker.synchronize(3, 1);
+            Assert::AreEqual(0, tracker.committedIndex());
+            Assert::AreEqual(1, tracker.present(1));
+            Assert::AreEqual(2, tracker.currentIndex());
+            Assert::AreEqual(1, tracker.takePendingCommits());
+        }
+    };
+
+} // namespace
@@ -0,0 +1,4 @@
+// Variant of AlphaBlendingCS with smaller thread groups, for small layers.
+
+#define THREAD_GROUP_SIZE 8
+#include "AlphaBlendingCS.hlsl"
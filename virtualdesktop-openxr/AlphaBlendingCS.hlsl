@@ -2,14 +2,26 @@
 
 #include "AlphaBlending.hlsli"
 
+#ifndef THREAD_GROUP_SIZE
+#define THREAD_GROUP_SIZE 32
+#endif
+
 cbuffer config : register(b0) {
     bool ignoreAlpha;
     bool isUnpremultipliedAlpha;
+    uint2 offset;
+    uint2 extent;
 };
 
 RWTexture2D<unorm float4> inoutTexture : register(u0);
 
-[numthreads(32, 32, 1)]
-void main(uint2 pos : SV_DispatchThreadID) {
+[numthreads(THREAD_GROUP_SIZE, THREAD_GROUP_SIZE, 1)]
+void main(uint2 id : SV_DispatchThreadID) {
+    // The last thread groups may overlap the edges of the image rect.
+    if (any(id >= extent)) {
+        return;
+    }
+
+    const uint2 pos = offset + id;
     inoutTexture[pos] = processAlpha(inoutTexture[pos], pos, ignoreAlpha, isUnpremultipliedAlpha);
 }
@@ -108,21 +108,20 @@ namespace virtualdesktop_openxr {
 
         std::shared_lock lock(m_actionsAndSpacesMutex);
 
-        const auto it = m_strings.find(path);
-        if (it == m_strings.cend()) {
+        const auto str = m_strings.lookup(path);
+        if (!str) {
             return XR_ERROR_PATH_INVALID;
         }
 
-        const auto& str = it->second;
-        if (bufferCapacityInput && bufferCapacityInput < str.length()) {
+        if (bufferCapacityInput && bufferCapacityInput < str->length()) {
             return XR_ERROR_SIZE_INSUFFICIENT;
         }
 
-        *bufferCountOutput = (uint32_t)str.length() + 1;
+        *bufferCountOutput = (uint32_t)str->length() + 1;
         TraceLoggingWrite(g_traceProvider, "xrPathToString", TLArg(*bufferCountOutput, "BufferCountOutput"));
 
         if (bufferCapacityInput && buffer) {
-            sprintf_s(buffer, bufferCapacityInput, "%s", str.c_str());
+            sprintf_s(buffer, bufferCapacityInput, "%s", str->data());
             TraceLoggingWrite(g_traceProvider, "xrPathToString", TLArg(buffer, "String"));
         }
 
@@ -175,12 +174,11 @@ namespace virtualdesktop_openxr {
             }
         }
 
-        // CONFORMANCE: We do not support the notion of priority. TODO: Sort actionSources by priority.
-
         // Create the internal struct.
         ActionSet& xrActionSet = *new ActionSet;
         xrActionSet.name = name;
         xrActionSet.localizedName = localizedName;
+        xrActionSet.priority = createInfo->priority;
 
         *actionSet = (XrActionSet)&xrActionSet;
 
@@ -240,7 +238,7 @@ namespace virtualdesktop_openxr {
         for (uint32_t i = 0; i < createInfo->countSubactionPaths; i++) {
             TraceLoggingWrite(g_traceProvider,
                               "xrCreateAction",
-                              TLArg(getXrPath(createInfo->subactionPaths[i]).c_str(), "SubactionPath"));
+                              TLArg(getXrPath(createInfo->subactionPaths[i]).data(), "SubactionPath"));
         }
 
         if (createInfo->actionType != XR_ACTION_TYPE_BOOLEAN_INPUT &&
@@ -292,7 +290,7 @@ namespace virtualdesktop_openxr {
 
         std::set<XrPath> subactionPaths;
         for (uint32_t i = 0; i < createInfo->countSubactionPaths; i++) {
-            const std::string& subactionPath = getXrPath(createInfo->subactionPaths[i]);
+            const std::string_view subactionPath = getXrPath(createInfo->subactionPaths[i]);
             if (subactionPath != "/user/hand/left" && subactionPath != "/user/hand/right" &&
                 subactionPath != "/user/gamepad" && subactionPath != "/user/head" &&
                 (!has_XR_EXT_eye_gaze_interaction || subactionPath != "/user/eyes_ext") &&
@@ -355,7 +353,7 @@ namespace virtualdesktop_openxr {
         TraceLoggingWrite(g_traceProvider,
                           "xrSuggestInteractionProfileBindings",
                           TLXArg(instance, "Instance"),
-                          TLArg(getXrPath(suggestedBindings->interactionProfile).c_str(), "InteractionProfile"));
+                          TLArg(getXrPath(suggestedBindings->interactionProfile).data(), "InteractionProfile"));
 
         if (!m_instanceCreated || instance != (XrInstance)1) {
             return XR_ERROR_HANDLE_INVALID;
@@ -369,7 +367,7 @@ namespace virtualdesktop_openxr {
             TraceLoggingWrite(g_traceProvider,
                               "xrSuggestInteractionProfileBindings",
                               TLXArg(suggestedBindings->suggestedBindings[i].action, "Action"),
-                              TLArg(getXrPath(suggestedBindings->suggestedBindings[i].binding).c_str(), "Path"));
+                              TLArg(getXrPath(suggestedBindings->suggestedBindings[i].binding).data(), "Path"));
         }
 
         std::unique_lock lock(m_actionsAndSpacesMutex);
@@ -378,7 +376,7 @@ namespace virtualdesktop_openxr {
             return XR_ERROR_ACTIONSETS_ALREADY_ATTACHED;
         }
 
-        const std::string& interactionProfile = getXrPath(suggestedBindings->interactionProfile);
+        const std::string interactionProfile(getXrPath(suggestedBindings->interactionProfile));
         const bool isEyeTracker = interactionProfile == "/interaction_profiles/ext/eye_gaze_interaction";
         const bool isViveTracker = interactionProfile == "/interaction_profiles/htc/vive_tracker_htcx";
         if (isEyeTracker) {
@@ -389,7 +387,7 @@ namespace virtualdesktop_openxr {
 
             // Eye tracker does not go through the controller mappings. Instead, we directly bind the action source.
             for (uint32_t i = 0; i < suggestedBindings->countSuggestedBindings; i++) {
-                const std::string& path = getXrPath(suggestedBindings->suggestedBindings[i].binding);
+                const std::string path(getXrPath(suggestedBindings->suggestedBindings[i].binding));
                 if (!isActionEyeTracker(path)) {
                     return XR_ERROR_PATH_UNSUPPORTED;
                 }
@@ -421,7 +419,7 @@ namespace virtualdesktop_openxr {
 
             std::vector<XrActionSuggestedBinding> bindings;
             for (uint32_t i = 0; i < suggestedBindings->countSuggestedBindings; i++) {
-                const std::string& path = getXrPath(suggestedBindings->suggestedBindings[i].binding);
+                const std::string path(getXrPath(suggestedBindings->suggestedBindings[i].binding));
                 if (getActionSide(path, true) < 0 || !checkValidPathIt->second(path)) {
                     return XR_ERROR_PATH_UNSUPPORTED;
                 }
@@ -439,7 +437,7 @@ namespace virtualdesktop_openxr {
                 bindings.push_back(suggestedBindings->suggestedBindings[i]);
             }
 
-            m_suggestedBindings.insert_or_assign(getXrPath(suggestedBindings->interactionProfile), bindings);
+            m_suggestedBindings.insert_or_assign(interactionProfile, bindings);
         }
 
         if (isViveTracker) {
@@ -496,6 +494,11 @@ namespace virtualdesktop_openxr {
             }
         }
 
+        // Resolve the bindings that do not depend on the controllers (eg: eye tracker, trackers).
+        for (const auto& action : m_actions) {
+            compileActionBindings(*(Action*)action);
+        }
+
         return XR_SUCCESS;
     }
 
@@ -510,7 +513,7 @@ namespace virtualdesktop_openxr {
         TraceLoggingWrite(g_traceProvider,
                           "xrGetCurrentInteractionProfile",
                           TLXArg(session, "Session"),
-                          TLArg(getXrPath(topLevelUserPath).c_str(), "TopLevelUserPath"));
+                          TLArg(getXrPath(topLevelUserPath).data(), "TopLevelUserPath"));
 
         if (!m_sessionCreated || session != (XrSession)1) {
             return XR_ERROR_HANDLE_INVALID;
@@ -547,7 +550,7 @@ namespace virtualdesktop_openxr {
 
         TraceLoggingWrite(g_traceProvider,
                           "xrGetCurrentInteractionProfile",
-                          TLArg(getXrPath(interactionProfile->interactionProfile).c_str(), "InteractionProfile"));
+                          TLArg(getXrPath(interactionProfile->interactionProfile).data(), "InteractionProfile"));
 
         return XR_SUCCESS;
     }
@@ -564,13 +567,13 @@ namespace virtualdesktop_openxr {
                           "xrGetActionStateBoolean",
                           TLXArg(session, "Session"),
                           TLXArg(getInfo->action, "Action"),
-                          TLArg(getXrPath(getInfo->subactionPath).c_str(), "SubactionPath"));
+                          TLArg(getXrPath(getInfo->subactionPath).data(), "SubactionPath"));
 
         if (!m_sessionCreated || session != (XrSession)1) {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        std::unique_lock lock(m_actionsAndSpacesMutex);
+        std::shared_lock lock(m_actionsAndSpacesMutex);
 
         if (!m_actions.count(getInfo->action)) {
             return XR_ERROR_HANDLE_INVALID;
@@ -587,7 +590,7 @@ namespace virtualdesktop_openxr {
         }
 
         if (getInfo->subactionPath != XR_NULL_PATH) {
-            if (m_strings.find(getInfo->subactionPath) == m_strings.cend()) {
+            if (!m_strings.contains(getInfo->subactionPath)) {
                 return XR_ERROR_PATH_INVALID;
             }
             if (!xrAction.subactionPaths.count(getInfo->subactionPath)) {
@@ -595,42 +598,32 @@ namespace virtualdesktop_openxr {
             }
         }
 
+        const ActionSet& xrActionSet = *(ActionSet*)xrAction.actionSet;
+        const uint8_t* const inputState = (const uint8_t*)&xrActionSet.cachedInputState;
+
         std::optional<bool> combinedState;
-        const std::string& subActionPath = getXrPath(getInfo->subactionPath);
-        const int subActionSide = std::max(0, getActionSide(subActionPath));
-        for (const auto& source : xrAction.actionSources) {
-            if (!startsWith(source.first, subActionPath)) {
+        const int subActionSide = std::max(0, getActionSide(getXrPath(getInfo->subactionPath)));
+        for (const auto& binding : xrAction.bindings) {
+            if ((getInfo->subactionPath != XR_NULL_PATH && binding.subactionPath != getInfo->subactionPath) ||
+                !m_isControllerActive[binding.side] || binding.isSuppressed) {
                 continue;
             }
 
-            const std::string& fullPath = source.first;
-            const auto& value = source.second;
-            const bool isBound = value.buttonMap != nullptr || value.floatValue != nullptr;
-            TraceLoggingWrite(g_traceProvider,
-                              "xrGetActionStateBoolean",
-                              TLArg(fullPath.c_str(), "ActionSourcePath"),
-                              TLArg(isBound, "Bound"));
-
-            // We only support hands paths, not gamepad etc.
-            const int side = getActionSide(fullPath);
-            if (isBound && side >= 0) {
-                if (m_isControllerActive[side]) {
-                    // Per spec, the combined state is the OR of all values.
-                    if (value.buttonMap) {
-                        combinedState = combinedState.value_or(false) || *value.buttonMap & value.buttonType;
-                    } else if (value.floatValue) {
-                        combinedState = combinedState.value_or(false) || value.floatValue[side] > 0.5f;
-                    }
-                }
-            }
+            // Per spec, the combined state is the OR of all values.
+            const bool value = binding.kind == ActionBindingKind::Button
+                                   ? *(const uint32_t*)(inputState + binding.offset) & binding.buttonMask
+                                   : *(const float*)(inputState + binding.offset) > binding.threshold;
+            combinedState = combinedState.value_or(false) || value;
         }
 
+        // Getters run concurrently under the shared lock, but they also track the last value reported.
+        std::unique_lock lastValueLock(xrAction.lastValueMutex);
+
         state->isActive = combinedState ? XR_TRUE : XR_FALSE;
         if (combinedState) {
             state->currentState = combinedState.value();
             state->changedSinceLastSync = !!state->currentState != xrAction.lastBoolValue[subActionSide];
 
-            const ActionSet& xrActionSet = *(ActionSet*)xrAction.actionSet;
             state->lastChangeTime = state->changedSinceLastSync
                                         ? ovrTimeToXrTime(xrActionSet.cachedInputState.TimeInSeconds)
                                         : xrAction.lastBoolValueChangedTime[subActionSide];
@@ -664,13 +657,13 @@ namespace virtualdesktop_openxr {
                           "xrGetActionStateFloat",
                           TLXArg(session, "Session"),
                           TLXArg(getInfo->action, "Action"),
-                          TLArg(getXrPath(getInfo->subactionPath).c_str(), "SubactionPath"));
+                          TLArg(getXrPath(getInfo->subactionPath).data(), "SubactionPath"));
 
         if (!m_sessionCreated || session != (XrSession)1) {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        std::unique_lock lock(m_actionsAndSpacesMutex);
+        std::shared_lock lock(m_actionsAndSpacesMutex);
 
         if (!m_actions.count(getInfo->action)) {
             return XR_ERROR_HANDLE_INVALID;
@@ -687,7 +680,7 @@ namespace virtualdesktop_openxr {
         }
 
         if (getInfo->subactionPath != XR_NULL_PATH) {
-            if (m_strings.find(getInfo->subactionPath) == m_strings.cend()) {
+            if (!m_strings.contains(getInfo->subactionPath)) {
                 return XR_ERROR_PATH_INVALID;
             }
             if (!xrAction.subactionPaths.count(getInfo->subactionPath)) {
@@ -695,50 +688,31 @@ namespace virtualdesktop_openxr {
             }
         }
 
+        const ActionSet& xrActionSet = *(ActionSet*)xrAction.actionSet;
+        const uint8_t* const inputState = (const uint8_t*)&xrActionSet.cachedInputState;
+
         std::optional<float> combinedState;
-        const std::string& subActionPath = getXrPath(getInfo->subactionPath);
-        const int subActionSide = std::max(0, getActionSide(subActionPath));
-        for (const auto& source : xrAction.actionSources) {
-            if (!startsWith(source.first, subActionPath)) {
+        const int subActionSide = std::max(0, getActionSide(getXrPath(getInfo->subactionPath)));
+        for (const auto& binding : xrAction.bindings) {
+            if ((getInfo->subactionPath != XR_NULL_PATH && binding.subactionPath != getInfo->subactionPath) ||
+                !m_isControllerActive[binding.side] || binding.isSuppressed) {
                 continue;
             }
 
-            const std::string& fullPath = source.first;
-            const auto& value = source.second;
-            const bool isBound = value.floatValue != nullptr ||
-                                 (value.vector2fValue != nullptr && value.vector2fIndex >= 0) ||
-                                 value.buttonMap != nullptr;
-            TraceLoggingWrite(g_traceProvider,
-                              "xrGetActionStateFloat",
-                              TLArg(fullPath.c_str(), "ActionSourcePath"),
-                              TLArg(isBound, "Bound"));
-
-            // We only support hands paths, not gamepad etc.
-            const int side = getActionSide(fullPath);
-            if (isBound && side >= 0) {
-                if (m_isControllerActive[side]) {
-                    // Per spec, the combined state is the absolute maximum of all values.
-                    if (value.floatValue) {
-                        combinedState = std::max(combinedState.value_or(-std::numeric_limits<float>::infinity()),
-                                                 value.floatValue[side]);
-                    } else if (value.buttonMap) {
-                        combinedState = std::max(combinedState.value_or(-std::numeric_limits<float>::infinity()),
-                                                 *value.buttonMap & value.buttonType ? 1.f : 0.f);
-                    } else if (value.vector2fValue) {
-                        combinedState = std::max(combinedState.value_or(-std::numeric_limits<float>::infinity()),
-                                                 value.vector2fIndex == 0 ? value.vector2fValue[side].x
-                                                                          : value.vector2fValue[side].y);
-                    }
-                }
-            }
+            // Per spec, the combined state is the absolute maximum of all values.
+            const float value = binding.kind == ActionBindingKind::Button
+                                    ? (*(const uint32_t*)(inputState + binding.offset) & binding.buttonMask ? 1.f : 0.f)
+                                    : *(const float*)(inputState + binding.offset);
+            combinedState = std::max(combinedState.value_or(-std::numeric_limits<float>::infinity()), value);
         }
 
+        std::unique_lock lastValueLock(xrAction.lastValueMutex);
+
         state->isActive = combinedState ? XR_TRUE : XR_FALSE;
         if (combinedState) {
             state->currentState = combinedState.value();
             state->changedSinceLastSync = state->currentState != xrAction.lastFloatValue[subActionSide];
 
-            const ActionSet& xrActionSet = *(ActionSet*)xrAction.actionSet;
             state->lastChangeTime = state->changedSinceLastSync
                                         ? ovrTimeToXrTime(xrActionSet.cachedInputState.TimeInSeconds)
                                         : xrAction.lastFloatValueChangedTime[subActionSide];
@@ -773,13 +747,13 @@ namespace virtualdesktop_openxr {
                           "xrGetActionStateVector2f",
                           TLXArg(session, "Session"),
                           TLXArg(getInfo->action, "Action"),
-                          TLArg(getXrPath(getInfo->subactionPath).c_str(), "SubactionPath"));
+                          TLArg(getXrPath(getInfo->subactionPath).data(), "SubactionPath"));
 
         if (!m_sessionCreated || session != (XrSession)1) {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        std::unique_lock lock(m_actionsAndSpacesMutex);
+        std::shared_lock lock(m_actionsAndSpacesMutex);
 
         if (!m_actions.count(getInfo->action)) {
             return XR_ERROR_HANDLE_INVALID;
@@ -796,7 +770,7 @@ namespace virtualdesktop_openxr {
         }
 
         if (getInfo->subactionPath != XR_NULL_PATH) {
-            if (m_strings.find(getInfo->subactionPath) == m_strings.cend()) {
+            if (!m_strings.contains(getInfo->subactionPath)) {
                 return XR_ERROR_PATH_INVALID;
             }
             if (!xrAction.subactionPaths.count(getInfo->subactionPath)) {
@@ -804,39 +778,31 @@ namespace virtualdesktop_openxr {
             }
         }
 
+        const ActionSet& xrActionSet = *(ActionSet*)xrAction.actionSet;
+        const uint8_t* const inputState = (const uint8_t*)&xrActionSet.cachedInputState;
+
         std::optional<XrVector2f> combinedState;
-        const std::string& subActionPath = getXrPath(getInfo->subactionPath);
-        const int subActionSide = std::max(0, getActionSide(subActionPath));
-        for (const auto& source : xrAction.actionSources) {
-            if (!startsWith(source.first, subActionPath)) {
+        const int subActionSide = std::max(0, getActionSide(getXrPath(getInfo->subactionPath)));
+        for (const auto& binding : xrAction.bindings) {
+            if ((getInfo->subactionPath != XR_NULL_PATH && binding.subactionPath != getInfo->subactionPath) ||
+                !m_isControllerActive[binding.side] || binding.isSuppressed) {
                 continue;
             }
 
-            const std::string& fullPath = source.first;
-            const auto& value = source.second;
-            const bool isBound = value.vector2fValue != nullptr;
-            TraceLoggingWrite(g_traceProvider,
-                              "xrGetActionStateVector2f",
-                              TLArg(fullPath.c_str(), "ActionSourcePath"),
-                              TLArg(isBound, "Bound"));
-
-            // We only support hands paths, not gamepad etc.
-            const int side = getActionSide(fullPath);
-            if (isBound && side >= 0) {
-                if (m_isControllerActive[side] && value.vector2fValue) {
-                    // Per spec, the combined state if the one of the vector with the longest length.
-                    const float l1 = combinedState ? sqrt(combinedState.value().x * combinedState.value().x +
-                                                          combinedState.value().y * combinedState.value().y)
-                                                   : 0.f;
-                    const XrVector2f vector2fValue = {value.vector2fValue[side].x, value.vector2fValue[side].y};
-                    const float l2 = sqrt(vector2fValue.x * vector2fValue.x + vector2fValue.y * vector2fValue.y);
-                    if (l2 >= l1) {
-                        combinedState = vector2fValue;
-                    }
-                }
+            // Per spec, the combined state if the one of the vector with the longest length.
+            const float l1 = combinedState ? sqrt(combinedState.value().x * combinedState.value().x +
+                                                  combinedState.value().y * combinedState.value().y)
+                                           : 0.f;
+            const ovrVector2f& value = *(const ovrVector2f*)(inputState + binding.offset);
+            const XrVector2f vector2fValue = {value.x, value.y};
+            const float l2 = sqrt(vector2fValue.x * vector2fValue.x + vector2fValue.y * vector2fValue.y);
+            if (l2 >= l1) {
+                combinedState = vector2fValue;
             }
         }
 
+        std::unique_lock lastValueLock(xrAction.lastValueMutex);
+
         state->isActive = combinedState ? XR_TRUE : XR_FALSE;
         if (combinedState) {
             state->currentState = combinedState.value();
@@ -844,7 +810,6 @@ namespace virtualdesktop_openxr {
             state->changedSinceLastSync = state->currentState.x != xrAction.lastVector2fValue[subActionSide].x ||
                                           state->currentState.y != xrAction.lastVector2fValue[subActionSide].y;
 
-            const ActionSet& xrActionSet = *(ActionSet*)xrAction.actionSet;
             state->lastChangeTime = state->changedSinceLastSync
                                         ? ovrTimeToXrTime(xrActionSet.cachedInputState.TimeInSeconds)
                                         : xrAction.lastVector2fValueChangedTime[subActionSide];
@@ -880,13 +845,13 @@ namespace virtualdesktop_openxr {
                           "xrGetActionStatePose",
                           TLXArg(session, "Session"),
                           TLXArg(getInfo->action, "Action"),
-                          TLArg(getXrPath(getInfo->subactionPath).c_str(), "SubactionPath"));
+                          TLArg(getXrPath(getInfo->subactionPath).data(), "SubactionPath"));
 
         if (!m_sessionCreated || session != (XrSession)1) {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        std::unique_lock lock(m_actionsAndSpacesMutex);
+        std::shared_lock lock(m_actionsAndSpacesMutex);
 
         if (!m_actions.count(getInfo->action)) {
             return XR_ERROR_HANDLE_INVALID;
@@ -903,7 +868,7 @@ namespace virtualdesktop_openxr {
         }
 
         if (getInfo->subactionPath != XR_NULL_PATH) {
-            if (m_strings.find(getInfo->subactionPath) == m_strings.cend()) {
+            if (!m_strings.contains(getInfo->subactionPath)) {
                 return XR_ERROR_PATH_INVALID;
             }
             if (!xrAction.subactionPaths.count(getInfo->subactionPath)) {
@@ -911,35 +876,21 @@ namespace virtualdesktop_openxr {
             }
         }
 
-        const std::string& subActionPath = getXrPath(getInfo->subactionPath);
-        for (const auto& source : xrAction.actionSources) {
-            if (!startsWith(source.first, subActionPath)) {
+        for (const auto& binding : xrAction.bindings) {
+            if (getInfo->subactionPath != XR_NULL_PATH && binding.subactionPath != getInfo->subactionPath) {
                 continue;
             }
 
-            const std::string& fullPath = source.first;
-            TraceLoggingWrite(g_traceProvider, "xrGetActionStatePose", TLArg(fullPath.c_str(), "ActionSourcePath"));
-
-            // We only support hands paths and eye tracker, not gamepad etc.
-            if (!isActionEyeTracker(fullPath)) {
-                const int side = getActionSide(fullPath);
-                if (side >= 0) {
-                    state->isActive = m_isControllerActive[side] ? XR_TRUE : XR_FALSE;
-
-                    // Per spec we must consistently pick one source. We pick the first one.
-                    break;
-                } else if (getTrackerIndex(fullPath) >= 0) {
-                    state->isActive = XR_TRUE;
-
-                    // Per spec we must consistently pick one source. We pick the first one.
-                    break;
-                }
+            if (binding.kind == ActionBindingKind::ControllerPose) {
+                state->isActive = m_isControllerActive[binding.side] ? XR_TRUE : XR_FALSE;
+            } else if (binding.kind == ActionBindingKind::TrackerPose) {
+                state->isActive = XR_TRUE;
             } else {
                 state->isActive = (m_eyeTrackingType != EyeTracking::None) ? XR_TRUE : XR_FALSE;
-
-                // Per spec we must consistently pick one source. We pick the first one.
-                break;
             }
+
+            // Per spec we must consistently pick one source. We pick the first one.
+            break;
         }
 
         TraceLoggingWrite(g_traceProvider, "xrGetActionStatePose", TLArg(!!state->isActive, "Active"));
@@ -949,6 +900,8 @@ namespace virtualdesktop_openxr {
 
     // https://www.khronos.org/registry/OpenXR/specs/1.0/html/xrspec.html#xrSyncActions
     XrResult OpenXrRuntime::xrSyncActions(XrSession session, const XrActionsSyncInfo* syncInfo) {
+        auto timeline = m_timeline.scope(TimelineEvent::SyncActions);
+
         if (syncInfo->type != XR_TYPE_ACTIONS_SYNC_INFO) {
             return XR_ERROR_VALIDATION_FAILURE;
         }
@@ -958,15 +911,16 @@ namespace virtualdesktop_openxr {
             TraceLoggingWrite(g_traceProvider,
                               "xrSyncActions",
                               TLXArg(syncInfo->activeActionSets[i].actionSet, "ActionSet"),
-                              TLArg(getXrPath(syncInfo->activeActionSets[i].subactionPath).c_str(), "SubactionPath"));
+                              TLArg(getXrPath(syncInfo->activeActionSets[i].subactionPath).data(), "SubactionPath"));
         }
 
         if (!m_sessionCreated || session != (XrSession)1) {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        // TODO: Try to reduce contention here.
-        std::unique_lock lock(m_actionsAndSpacesMutex);
+        // Only block the other readers while publishing the new state. The validation only needs to read, and the
+        // LibOVR calls do not need the lock at all.
+        std::shared_lock validationLock(m_actionsAndSpacesMutex);
 
         bool doSide[xr::Side::Count] = {false, false};
         for (uint32_t i = 0; i < syncInfo->countActiveActionSets; i++) {
@@ -991,18 +945,32 @@ namespace virtualdesktop_openxr {
         }
 
         if (m_sessionState != XR_SESSION_STATE_FOCUSED) {
+            // This is a success code: the call is valid, there is simply no input to latch.
+            timeline.setArgs(0, syncInfo->countActiveActionSets);
+            timeline.setSucceeded();
             return XR_SESSION_NOT_FOCUSED;
         }
+        validationLock.unlock();
 
         // Latch the state of all inputs, and we will let the further calls to xrGetActionState*() do the triage.
-        CHECK_OVRCMD(ovr_GetInputState(m_ovrSession, ovrControllerType_Touch, &m_cachedInputState));
+        ovrInputState inputState{};
+        CHECK_OVRCMD(ovr_GetInputState(m_ovrSession, ovrControllerType_Touch, &inputState));
+        const auto controllerTypes = ovr_GetConnectedControllerTypes(m_ovrSession);
+        for (uint32_t side = 0; side < xr::Side::Count; side++) {
+            if (doSide[side] && (controllerTypes & (side == 0 ? ovrControllerType_LTouch : ovrControllerType_RTouch))) {
+                processHandGestures(side, inputState);
+            }
+        }
+
+        std::unique_lock lock(m_actionsAndSpacesMutex);
+
+        m_cachedInputState = inputState;
         for (uint32_t side = 0; side < xr::Side::Count; side++) {
             if (!doSide[side]) {
                 continue;
             }
 
             const auto lastControllerType = m_cachedControllerType[side];
-            const auto controllerTypes = ovr_GetConnectedControllerTypes(m_ovrSession);
             const bool isControllerConnected =
                 controllerTypes & (side == 0 ? ovrControllerType_LTouch : ovrControllerType_RTouch);
             if (isControllerConnected) {
@@ -1032,8 +1000,6 @@ namespace virtualdesktop_openxr {
                                       m_cachedInputState.ThumbstickNoDeadzone[side].y)
                               .c_str(),
                           "JoystickNoDeadzone"));
-
-                processHandGestures(side);
             } else {
                 m_cachedControllerType[side].clear();
                 m_isControllerActive[side] = false;
@@ -1065,24 +1031,10 @@ namespace virtualdesktop_openxr {
 
             xrActionSet.cachedInputState = m_cachedInputState;
         }
+        arbitrateActionSets(*syncInfo);
 
-        // Re-assert haptics to OVR. We do this regardless of actionsets being synced.
-        const auto now = std::chrono::high_resolution_clock::now();
-        for (uint32_t side = 0; side < xr::Side::Count; side++) {
-            if (m_currentVibration[side].duration > 0) {
-                const bool isExpired =
-                    (now - m_currentVibration[side].startTime).count() >= m_currentVibration[side].duration;
-                if (isExpired) {
-                    m_currentVibration[side].amplitude = m_currentVibration[side].frequency = 0.f;
-                    m_currentVibration[side].duration = 0;
-                }
-
-                CHECK_OVRCMD(ovr_SetControllerVibration(m_ovrSession,
-                                                        side == 0 ? ovrControllerType_LTouch : ovrControllerType_RTouch,
-                                                        m_currentVibration[side].frequency,
-                                                        m_currentVibration[side].amplitude));
-            }
-        }
+        timeline.setArgs(0, syncInfo->countActiveActionSets);
+        timeline.setSucceeded();
 
         return XR_SUCCESS;
     }
@@ -1130,7 +1082,7 @@ namespace virtualdesktop_openxr {
         if (sourceCapacityInput && sources) {
             uint32_t i = 0;
             for (const auto& source : xrAction.actionSources) {
-                sources[i] = stringToPath(source.second.realPath.c_str());
+                sources[i] = stringToPath(source.second.realPath);
                 TraceLoggingWrite(g_traceProvider,
                                   "xrEnumerateBoundSourcesForAction",
                                   TLArg(source.first.c_str(), "Source"),
@@ -1155,7 +1107,7 @@ namespace virtualdesktop_openxr {
         TraceLoggingWrite(g_traceProvider,
                           "xrGetInputSourceLocalizedName",
                           TLXArg(session, "Session"),
-                          TLArg(getXrPath(getInfo->sourcePath).c_str(), "SourcePath"),
+                          TLArg(getXrPath(getInfo->sourcePath).data(), "SourcePath"),
                           TLArg(getInfo->whichComponents, "WhichComponents"));
 
         if (!m_sessionCreated || session != (XrSession)1) {
@@ -1172,7 +1124,7 @@ namespace virtualdesktop_openxr {
             return XR_ERROR_VALIDATION_FAILURE;
         }
 
-        const std::string path = getXrPath(getInfo->sourcePath);
+        const std::string path(getXrPath(getInfo->sourcePath));
         if (path.empty() || path == "<unknown>") {
             return XR_ERROR_PATH_INVALID;
         }
@@ -1268,7 +1220,7 @@ namespace virtualdesktop_openxr {
                           "xrApplyHapticFeedback",
                           TLXArg(session, "Session"),
                           TLXArg(hapticActionInfo->action, "Action"),
-                          TLArg(getXrPath(hapticActionInfo->subactionPath).c_str(), "SubactionPath"));
+                          TLArg(getXrPath(hapticActionInfo->subactionPath).data(), "SubactionPath"));
 
         if (!m_sessionCreated || session != (XrSession)1) {
             return XR_ERROR_HANDLE_INVALID;
@@ -1295,7 +1247,7 @@ namespace virtualdesktop_openxr {
         }
 
         if (hapticActionInfo->subactionPath != XR_NULL_PATH) {
-            if (m_strings.find(hapticActionInfo->subactionPath) == m_strings.cend()) {
+            if (!m_strings.contains(hapticActionInfo->subactionPath)) {
                 return XR_ERROR_PATH_INVALID;
             }
             if (!xrAction.subactionPaths.count(hapticActionInfo->subactionPath)) {
@@ -1303,7 +1255,7 @@ namespace virtualdesktop_openxr {
             }
         }
 
-        const std::string& subActionPath = getXrPath(hapticActionInfo->subactionPath);
+        const std::string_view subActionPath = getXrPath(hapticActionInfo->subactionPath);
         for (const auto& source : xrAction.actionSources) {
             if (!startsWith(source.first, subActionPath)) {
                 continue;
@@ -1327,25 +1279,18 @@ namespace virtualdesktop_openxr {
                                           TLArg(vibration->frequency, "Frequency"),
                                           TLArg(vibration->duration, "Duration"));
 
-                        m_currentVibration[side].startTime = std::chrono::high_resolution_clock::now();
-                        m_currentVibration[side].amplitude = vibration->amplitude;
                         if (vibration->amplitude > 0) {
                             // Haptic Reactor's ideal resonance is at 160 Hz for low frequency.
-                            m_currentVibration[side].frequency =
-                                vibration->frequency == XR_FREQUENCY_UNSPECIFIED ? 160 : vibration->frequency;
                             // General recommendation is 20ms for short pulses.
-                            m_currentVibration[side].duration = std::max((XrDuration)20'000'000, vibration->duration);
+                            scheduleVibration(
+                                side,
+                                vibration->frequency == XR_FREQUENCY_UNSPECIFIED ? 160 : vibration->frequency,
+                                vibration->amplitude,
+                                std::max((XrDuration)20'000'000, vibration->duration));
                         } else {
                             // OpenComposite seems to pass an amplitude of 0 sometimes. Assume this means stopping.
-                            m_currentVibration[side].frequency = 0.f;
-                            m_currentVibration[side].duration = 0;
+                            scheduleVibration(side, 0.f, 0.f, 0);
                         }
-
-                        CHECK_OVRCMD(
-                            ovr_SetControllerVibration(m_ovrSession,
-                                                       side == 0 ? ovrControllerType_LTouch : ovrControllerType_RTouch,
-                                                       m_currentVibration[side].frequency,
-                                                       vibration->amplitude));
                         break;
                     }
 
@@ -1367,7 +1312,7 @@ namespace virtualdesktop_openxr {
                           "xrStopHapticFeedback",
                           TLXArg(session, "Session"),
                           TLXArg(hapticActionInfo->action, "Action"),
-                          TLArg(getXrPath(hapticActionInfo->subactionPath).c_str(), "SubactionPath"));
+                          TLArg(getXrPath(hapticActionInfo->subactionPath).data(), "SubactionPath"));
 
         if (!m_sessionCreated || session != (XrSession)1) {
             return XR_ERROR_HANDLE_INVALID;
@@ -1390,7 +1335,7 @@ namespace virtualdesktop_openxr {
         }
 
         if (hapticActionInfo->subactionPath != XR_NULL_PATH) {
-            if (m_strings.find(hapticActionInfo->subactionPath) == m_strings.cend()) {
+            if (!m_strings.contains(hapticActionInfo->subactionPath)) {
                 return XR_ERROR_PATH_INVALID;
             }
             if (!xrAction.subactionPaths.count(hapticActionInfo->subactionPath)) {
@@ -1398,7 +1343,7 @@ namespace virtualdesktop_openxr {
             }
         }
 
-        const std::string& subActionPath = getXrPath(hapticActionInfo->subactionPath);
+        const std::string_view subActionPath = getXrPath(hapticActionInfo->subactionPath);
         for (const auto& source : xrAction.actionSources) {
             if (!startsWith(source.first, subActionPath)) {
                 continue;
@@ -1411,11 +1356,7 @@ namespace virtualdesktop_openxr {
             // We only support hands paths, not gamepad etc.
             const int side = getActionSide(fullPath);
             if (isOutput && side >= 0) {
-                m_currentVibration[side].amplitude = m_currentVibration[side].frequency = 0.f;
-                m_currentVibration[side].duration = 0;
-
-                CHECK_OVRCMD(ovr_SetControllerVibration(
-                    m_ovrSession, side == 0 ? ovrControllerType_LTouch : ovrControllerType_RTouch, 0.f, 0.f));
+                scheduleVibration(side, 0.f, 0.f, 0);
             }
         }
 
@@ -1543,7 +1484,7 @@ namespace virtualdesktop_openxr {
                         continue;
                     }
 
-                    const auto& sourcePath = getXrPath(binding.binding);
+                    const std::string_view sourcePath = getXrPath(binding.binding);
                     if (getActionSide(sourcePath) != side) {
                         continue;
                     }
@@ -1567,7 +1508,7 @@ namespace virtualdesktop_openxr {
                                               "xrSyncActions_MapActionSource",
                                               TLXArg(binding.action, "Action"),
                                               TLXArg(xrAction.actionSet, "ActionSet"),
-                                              TLArg(sourcePath.c_str(), "ActionPath"),
+                                              TLArg(sourcePath.data(), "ActionPath"),
                                               TLArg(newSource.realPath.c_str(), "SourcePath"),
                                               TLArg(!!newSource.buttonMap, "IsButton"),
                                               TLArg(!!newSource.floatValue, "IsFloat"),
@@ -1590,7 +1531,7 @@ namespace virtualdesktop_openxr {
                             newSource.floatValue = (float*)relocatePointer((void*)newSource.floatValue);
                             newSource.vector2fValue = (ovrVector2f*)relocatePointer((void*)newSource.vector2fValue);
 
-                            xrAction.actionSources.insert_or_assign(sourcePath, std::move(newSource));
+                            xrAction.actionSources.insert_or_assign(std::string(sourcePath), std::move(newSource));
                         }
                     }
                 }
@@ -1606,7 +1547,7 @@ namespace virtualdesktop_openxr {
         if (!actualInteractionProfile.empty()) {
             Log("Using interaction profile: %s (%s)\n", actualInteractionProfile.c_str(), side == 0 ? "Left" : "Right");
 
-            m_currentInteractionProfile[side] = stringToPath(actualInteractionProfile.c_str());
+            m_currentInteractionProfile[side] = stringToPath(actualInteractionProfile);
 
             auto adjustedGripPose = Pose::Multiply(m_controllerGripOffset, gripPose);
             auto adjustedAimPose = Pose::Multiply(m_controllerAimOffset, aimPose);
@@ -1639,38 +1580,35 @@ namespace virtualdesktop_openxr {
         m_currentInteractionProfileDirty =
             m_currentInteractionProfileDirty ||
             (m_currentInteractionProfile[side] != prevInterationProfile && !m_activeActionSets.empty());
+
+        // Refresh the bindings used by xrGetActionState*().
+        for (const auto& action : m_actions) {
+            compileActionBindings(*(Action*)action);
+        }
     }
 
-    std::string OpenXrRuntime::getXrPath(XrPath path) const {
+    std::string_view OpenXrRuntime::getXrPath(XrPath path) const {
         if (path == XR_NULL_PATH) {
             return "";
         }
 
-        const auto it = m_strings.find(path);
-        if (it == m_strings.cend()) {
-            return "<unknown>";
-        }
-
-        return it->second;
+        return m_strings.lookup(path).value_or("<unknown>");
     }
 
-    XrPath OpenXrRuntime::stringToPath(const std::string& path, bool validate) {
-        for (auto entry : m_strings) {
-            if (entry.second == path) {
-                return entry.first;
-            }
+    XrPath OpenXrRuntime::stringToPath(std::string_view path, bool validate) {
+        const XrPath existing = m_strings.find(path);
+        if (existing != XR_NULL_PATH) {
+            return existing;
         }
 
-        if (path.length() >= XR_MAX_PATH_LENGTH || !validatePath(path)) {
+        if (path.length() >= XR_MAX_PATH_LENGTH || !validatePath(std::string(path))) {
             return XR_NULL_PATH;
         }
 
-        m_stringIndex++;
-        m_strings.insert_or_assign(m_stringIndex, path);
-        return (XrPath)m_stringIndex;
+        return m_strings.intern(path);
     }
 
-    int OpenXrRuntime::getActionSide(const std::string& fullPath, bool allowExtraPaths) const {
+    int OpenXrRuntime::getActionSide(std::string_view fullPath, bool allowExtraPaths) const {
         if (startsWith(fullPath, "/user/hand/left")) {
             return xr::Side::Left;
         } else if (startsWith(fullPath, "/user/hand/right")) {
@@ -1684,7 +1622,7 @@ namespace virtualdesktop_openxr {
         return -1;
     }
 
-    bool OpenXrRuntime::isActionEyeTracker(const std::string& fullPath) const {
+    bool OpenXrRuntime::isActionEyeTracker(std::string_view fullPath) const {
         return fullPath == "/user/eyes_ext/input/gaze_ext/pose" || fullPath == "/user/eyes_ext/input/gaze_ext";
     }
 
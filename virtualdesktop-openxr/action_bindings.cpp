@@ -0,0 +1,224 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "log.h"
+#include "runtime.h"
+#include "utils.h"
+
+namespace virtualdesktop_openxr {
+
+    using namespace virtualdesktop_openxr::log;
+    using namespace virtualdesktop_openxr::utils;
+
+    // Flatten the action sources of an action into a list of bindings that can be evaluated without any string
+    // manipulation. The order of the action sources is preserved, since xrGetActionStatePose() must consistently pick
+    // the first one.
+    void OpenXrRuntime::compileActionBindings(Action& xrAction) const {
+        xrAction.bindings.clear();
+
+        const ActionSet& xrActionSet = *(ActionSet*)xrAction.actionSet;
+        const auto offsetOf = [&](const void* pointer) {
+            return (uint32_t)((const uint8_t*)pointer - (const uint8_t*)&xrActionSet.cachedInputState);
+        };
+
+        for (const auto& source : xrAction.actionSources) {
+            const std::string& fullPath = source.first;
+            const auto& value = source.second;
+
+            ActionBinding binding{};
+            for (const auto& subactionPath : xrAction.subactionPaths) {
+                if (startsWith(fullPath, getXrPath(subactionPath))) {
+                    binding.subactionPath = subactionPath;
+                    break;
+                }
+            }
+
+            // We only support hands paths, not gamepad etc.
+            binding.side = getActionSide(fullPath);
+
+            bool isBound = false;
+            switch (xrAction.type) {
+            case XR_ACTION_TYPE_BOOLEAN_INPUT:
+                if (value.buttonMap) {
+                    binding.kind = ActionBindingKind::Button;
+                    binding.offset = offsetOf(value.buttonMap);
+                    binding.buttonMask = value.buttonType;
+                    isBound = true;
+                } else if (value.floatValue) {
+                    binding.kind = ActionBindingKind::Float;
+                    binding.threshold = 0.5f;
+                    isBound = true;
+                }
+                break;
+
+            case XR_ACTION_TYPE_FLOAT_INPUT:
+                if (value.floatValue) {
+                    binding.kind = ActionBindingKind::Float;
+                    isBound = true;
+                } else if (value.buttonMap) {
+                    binding.kind = ActionBindingKind::Button;
+                    binding.offset = offsetOf(value.buttonMap);
+                    binding.buttonMask = value.buttonType;
+                    isBound = true;
+                } else if (value.vector2fValue && value.vector2fIndex >= 0) {
+                    binding.kind = ActionBindingKind::Float;
+                    isBound = true;
+                }
+                break;
+
+            case XR_ACTION_TYPE_VECTOR2F_INPUT:
+                if (value.vector2fValue) {
+                    binding.kind = ActionBindingKind::Vector2f;
+                    isBound = true;
+                }
+                break;
+
+            case XR_ACTION_TYPE_POSE_INPUT:
+                // We only support hands paths and eye tracker, not gamepad etc.
+                if (isActionEyeTracker(fullPath)) {
+                    binding.kind = ActionBindingKind::EyeGazePose;
+                    isBound = true;
+                } else if (binding.side >= 0) {
+                    binding.kind = ActionBindingKind::ControllerPose;
+                    isBound = true;
+                } else if (getTrackerIndex(fullPath) >= 0) {
+                    binding.kind = ActionBindingKind::TrackerPose;
+                    isBound = true;
+                }
+                break;
+            }
+
+            if (!isBound || (xrAction.type != XR_ACTION_TYPE_POSE_INPUT && binding.side < 0)) {
+                continue;
+            }
+
+            // Resolve the per-hand values now.
+            if (binding.kind == ActionBindingKind::Float) {
+                if (value.floatValue) {
+                    binding.offset = offsetOf(&value.floatValue[binding.side]);
+                } else {
+                    binding.offset = offsetOf(value.vector2fIndex == 0 ? &value.vector2fValue[binding.side].x
+                                                                       : &value.vector2fValue[binding.side].y);
+                }
+            } else if (binding.kind == ActionBindingKind::Vector2f) {
+                binding.offset = offsetOf(&value.vector2fValue[binding.side]);
+            }
+
+            // A single axis of a thumbstick is the same physical input as the whole thumbstick.
+            if (binding.kind == ActionBindingKind::Button) {
+                binding.sourceId = (uint64_t)binding.offset << 32 | binding.buttonMask;
+            } else if (binding.kind == ActionBindingKind::Float || binding.kind == ActionBindingKind::Vector2f) {
+                const uint32_t componentOffset =
+                    value.floatValue ? binding.offset : offsetOf(&value.vector2fValue[binding.side]);
+                binding.sourceId = (uint64_t)componentOffset << 32;
+            }
+
+            TraceLoggingWrite(g_traceProvider,
+                              "CompileActionBinding",
+                              TLXArg(&xrAction, "Action"),
+                              TLArg(fullPath.c_str(), "ActionSourcePath"),
+                              TLArg((int)binding.kind, "Kind"),
+                              TLArg(binding.side, "Side"),
+                              TLArg(binding.offset, "Offset"));
+
+            xrAction.bindings.push_back(binding);
+        }
+    }
+
+    // Per spec, when an input is bound in several of the action sets being synced, only the actions from the action
+    // sets with the highest priority receive it. The others behave as if the input was not bound.
+    void OpenXrRuntime::arbitrateActionSets(const XrActionsSyncInfo& syncInfo) {
+        const XrActiveActionSetPrioritiesEXT* priorities = nullptr;
+
+        const XrBaseInStructure* entry = reinterpret_cast<const XrBaseInStructure*>(syncInfo.next);
+        while (entry) {
+            switch (entry->type) {
+            case XR_TYPE_ACTIVE_ACTION_SET_PRIORITIES_EXT:
+                priorities = reinterpret_cast<const XrActiveActionSetPrioritiesEXT*>(entry);
+                break;
+            }
+
+            entry = reinterpret_cast<const XrBaseInStructure*>(entry->next);
+        }
+
+        const auto getPriority = [&](XrActionSet actionSet) {
+            if (priorities) {
+                for (uint32_t i = 0; i < priorities->actionSetPriorityCount; i++) {
+                    if (priorities->actionSetPriorities[i].actionSet == actionSet) {
+                        return priorities->actionSetPriorities[i].priorityOverride;
+                    }
+                }
+            }
+            return ((const ActionSet*)actionSet)->priority;
+        };
+
+        const auto isSynced = [&](XrActionSet actionSet) {
+            for (uint32_t i = 0; i < syncInfo.countActiveActionSets; i++) {
+                if (syncInfo.activeActionSets[i].actionSet == actionSet) {
+                    return true;
+                }
+            }
+            return false;
+        };
+
+        // Find the owner (highest priority) of each input.
+        m_inputSourceOwners.clear();
+        for (const auto& action : m_actions) {
+            Action& xrAction = *(Action*)action;
+            if (!isSynced(xrAction.actionSet)) {
+                continue;
+            }
+
+            const uint32_t priority = getPriority(xrAction.actionSet);
+            for (const auto& binding : xrAction.bindings) {
+                if (binding.sourceId) {
+                    auto it = m_inputSourceOwners.try_emplace(binding.sourceId, priority).first;
+                    it->second = std::max(it->second, priority);
+                }
+            }
+        }
+
+        // Suppress the bindings that lost. Action sets not being synced keep the outcome of their last sync, like they
+        // keep their input state.
+        for (const auto& action : m_actions) {
+            Action& xrAction = *(Action*)action;
+            if (!isSynced(xrAction.actionSet)) {
+                continue;
+            }
+
+            const uint32_t priority = getPriority(xrAction.actionSet);
+            for (auto& binding : xrAction.bindings) {
+                binding.isSuppressed = binding.sourceId && m_inputSourceOwners[binding.sourceId] > priority;
+                if (binding.isSuppressed) {
+                    TraceLoggingWrite(g_traceProvider,
+                                      "SuppressActionBinding",
+                                      TLXArg(action, "Action"),
+                                      TLArg(binding.sourceId, "SourceId"),
+                                      TLArg(priority, "Priority"));
+                }
+            }
+        }
+    }
+
+} // namespace virtualdesktop_openxr
@@ -0,0 +1,91 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "pch.h"
+
+namespace virtualdesktop_openxr::utils {
+
+    // The region of a swapchain image covered by the alpha correction compute pass.
+    struct AlphaCorrectionDispatch {
+        uint32_t offset[2];
+        uint32_t extent[2];
+        uint32_t groupCount[2];
+    };
+
+    // Restrict the alpha correction pass to the image rect of the layer (clamped to the texture), with enough thread
+    // groups to cover partial tiles on the right and bottom edges. Returns nothing when there is nothing to process.
+    static inline std::optional<AlphaCorrectionDispatch>
+    PlanAlphaCorrectionDispatch(const XrRect2Di& imageRect, uint32_t width, uint32_t height, uint32_t groupSize) {
+        const int64_t left = std::clamp<int64_t>(imageRect.offset.x, 0, width);
+        const int64_t top = std::clamp<int64_t>(imageRect.offset.y, 0, height);
+        const int64_t right = std::clamp<int64_t>((int64_t)imageRect.offset.x + imageRect.extent.width, left, width);
+        const int64_t bottom =
+            std::clamp<int64_t>((int64_t)imageRect.offset.y + imageRect.extent.height, top, height);
+        if (right == left || bottom == top) {
+            return {};
+        }
+
+        AlphaCorrectionDispatch dispatch;
+        dispatch.offset[0] = (uint32_t)left;
+        dispatch.offset[1] = (uint32_t)top;
+        dispatch.extent[0] = (uint32_t)(right - left);
+        dispatch.extent[1] = (uint32_t)(bottom - top);
+        dispatch.groupCount[0] = (dispatch.extent[0] + groupSize - 1) / groupSize;
+        dispatch.groupCount[1] = (dispatch.extent[1] + groupSize - 1) / groupSize;
+        return dispatch;
+    }
+
+    // The smallest rect containing both rects.
+    static inline XrRect2Di UnionImageRect(const XrRect2Di& a, const XrRect2Di& b) {
+        const int64_t left = std::min(a.offset.x, b.offset.x);
+        const int64_t top = std::min(a.offset.y, b.offset.y);
+        const int64_t right = std::max((int64_t)a.offset.x + a.extent.width, (int64_t)b.offset.x + b.extent.width);
+        const int64_t bottom = std::max((int64_t)a.offset.y + a.extent.height, (int64_t)b.offset.y + b.extent.height);
+
+        XrRect2Di rect;
+        rect.offset.x = (int32_t)left;
+        rect.offset.y = (int32_t)top;
+        rect.extent.width = (int32_t)std::min<int64_t>(right - left, INT32_MAX);
+        rect.extent.height = (int32_t)std::min<int64_t>(bottom - top, INT32_MAX);
+        return rect;
+    }
+
+    // What was last pre-processed into a swapchain slice. When the application submits the same image again (it did
+    // not release a new one), with the same rect and flags, the pre-processed image can be presented as-is.
+    struct PreprocessedImage {
+        uint64_t releaseCount;
+        XrRect2Di imageRect;
+        bool clearAlpha;
+        bool premultiplyAlpha;
+
+        bool operator==(const PreprocessedImage& other) const {
+            return releaseCount == other.releaseCount && imageRect.offset.x == other.imageRect.offset.x &&
+                   imageRect.offset.y == other.imageRect.offset.y &&
+                   imageRect.extent.width == other.imageRect.extent.width &&
+                   imageRect.extent.height == other.imageRect.extent.height && clearAlpha == other.clearAlpha &&
+                   premultiplyAlpha == other.premultiplyAlpha;
+        }
+    };
+
+} // namespace virtualdesktop_openxr::utils
@@ -0,0 +1,360 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "pch.h"
+
+#include "BodyState.h"
+
+namespace virtualdesktop_openxr::utils {
+
+    // A short history of the body states received from Virtual Desktop, so that we can honor the time requested by
+    // the application instead of always returning the latest state.
+    // There is a single writer (the body state watcher thread) and any number of readers. Each slot is protected by a
+    // sequence counter (seqlock): the writer never waits, and readers retry whenever they observe a torn copy.
+    // A reader may copy a slot while the writer overwrites it, so the slot contents are only ever accessed through
+    // relaxed atomics (word by word for the state). This keeps the torn copies well-defined, rather than relying on
+    // the compiler treating a racy memcpy as benign.
+    class BodyStateHistory {
+      public:
+        static constexpr size_t k_capacity = 8;
+
+        enum class PredictionMode {
+            // Return the most recent sample preceding the requested time, as-is.
+            Hold = 0,
+            // Blend the two samples around the requested time, and hold the most recent sample past it.
+            Interpolate,
+            // Blend the two samples around the requested time, and extrapolate past the most recent sample.
+            Extrapolate,
+        };
+
+        // How far past the most recent sample each signal may be extrapolated, in seconds. 0 holds the last sample.
+        // The limits are only used in PredictionMode::Extrapolate.
+        struct PredictionLimits {
+            PredictionMode mode{PredictionMode::Extrapolate};
+            double joints{0.05};
+            double eyes{0.05};
+            double face{0.05};
+        };
+
+        void push(double time, const BodyTracking::BodyStateV2& state) {
+            const uint64_t index = m_writeCount.load(std::memory_order_relaxed);
+            Slot& slot = m_slots[index % k_capacity];
+
+            const uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+            slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            slot.index.store(index, std::memory_order_relaxed);
+            slot.time.store(time, std::memory_order_relaxed);
+            for (size_t i = 0; i < k_stateWords; i++) {
+                size_t word = 0;
+                memcpy(&word, reinterpret_cast<const uint8_t*>(&state) + i * sizeof(word), wordSize(i));
+                slot.state[i].store(word, std::memory_order_relaxed);
+            }
+            slot.sequence.store(sequence + 2, std::memory_order_release);
+
+            m_writeCount.store(index + 1, std::memory_order_release);
+        }
+
+        // Retrieve the most recent state.
+        bool latest(BodyTracking::BodyStateV2& state) const {
+            while (true) {
+                const uint64_t count = m_writeCount.load(std::memory_order_acquire);
+                if (!count) {
+                    return false;
+                }
+                double time;
+                if (readSlot(count - 1, time, &state)) {
+                    return true;
+                }
+            }
+        }
+
+        // The time of the most recent state.
+        std::optional<double> newestTime() const {
+            while (true) {
+                const uint64_t count = m_writeCount.load(std::memory_order_acquire);
+                if (!count) {
+                    return {};
+                }
+                double time;
+                if (readSlot(count - 1, time, nullptr)) {
+                    return time;
+                }
+            }
+        }
+
+        // Retrieve the state at the requested time, interpolating between the two samples around it. Past the most
+        // recent sample, each signal is extrapolated within its prediction limit.
+        bool sample(double time, const PredictionLimits& limits, BodyTracking::BodyStateV2& state) const {
+            const double maxPrediction = maxPredictionFor(limits);
+
+            const uint64_t count = m_writeCount.load(std::memory_order_acquire);
+            if (!count) {
+                return false;
+            }
+
+            // Leave one slot of slack, since the writer might be updating the slot past the newest one.
+            const uint64_t newest = count - 1;
+            const uint64_t oldest = count > k_capacity - 1 ? count - (k_capacity - 1) : 0;
+
+            // Find the most recent sample preceding the requested time.
+            uint64_t before = newest;
+            double beforeTime;
+            while (true) {
+                if (!readSlot(before, beforeTime, nullptr)) {
+                    return latest(state);
+                }
+                if (beforeTime <= time || before == oldest) {
+                    break;
+                }
+                before--;
+            }
+
+            if (beforeTime >= time || limits.mode == PredictionMode::Hold ||
+                (before == newest && (newest == oldest || maxPrediction <= 0.0))) {
+                return readSlot(before, beforeTime, &state) || latest(state);
+            }
+
+            // Either interpolate between (before, before + 1), or extrapolate from (newest - 1, newest).
+            const uint64_t first = before == newest ? newest - 1 : before;
+            Sample a, b;
+            if (!readSlot(first, a.time, &a.state) || !readSlot(first + 1, b.time, &b.state) || b.time <= a.time) {
+                return latest(state);
+            }
+
+            blend(a, b, time, limits, state);
+
+            return true;
+        }
+
+        // How far past the most recent sample any signal may be extrapolated, in seconds.
+        static double maxPredictionFor(const PredictionLimits& limits) {
+            if (limits.mode != PredictionMode::Extrapolate) {
+                return 0.0;
+            }
+            return std::max({limits.joints, limits.eyes, limits.face});
+        }
+
+      private:
+        static_assert(std::is_trivially_copyable_v<BodyTracking::BodyStateV2>);
+        static constexpr size_t k_stateWords =
+            (sizeof(BodyTracking::BodyStateV2) + sizeof(size_t) - 1) / sizeof(size_t);
+
+        struct Slot {
+            std::atomic<uint32_t> sequence{0};
+            std::atomic<uint64_t> index{0};
+            std::atomic<double> time{0.0};
+            std::atomic<size_t> state[k_stateWords]{};
+        };
+
+        struct Sample {
+            double time;
+            BodyTracking::BodyStateV2 state;
+        };
+
+        // Read a slot, only if it still holds the requested sample.
+        bool readSlot(uint64_t index, double& time, BodyTracking::BodyStateV2* state) const {
+            const Slot& slot = m_slots[index % k_capacity];
+            while (true) {
+                const uint32_t sequence = slot.sequence.load(std::memory_order_acquire);
+                if (sequence & 1) {
+                    YieldProcessor();
+                    continue;
+                }
+
+                const uint64_t slotIndex = slot.index.load(std::memory_order_relaxed);
+                time = slot.time.load(std::memory_order_relaxed);
+                if (state) {
+                    for (size_t i = 0; i < k_stateWords; i++) {
+                        const size_t word = slot.state[i].load(std::memory_order_relaxed);
+                        memcpy(reinterpret_cast<uint8_t*>(state) + i * sizeof(word), &word, wordSize(i));
+                    }
+                }
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.sequence.load(std::memory_order_relaxed) == sequence) {
+                    return slotIndex == index;
+                }
+            }
+        }
+
+        // The number of bytes of the state held by a word (the last word may be partial).
+        static constexpr size_t wordSize(size_t index) {
+            return std::min(sizeof(size_t), sizeof(BodyTracking::BodyStateV2) - index * sizeof(size_t));
+        }
+
+        static BodyTracking::Pose blendPose(const BodyTracking::Pose& a, const BodyTracking::Pose& b, float alpha) {
+            const DirectX::XMVECTOR orientation = DirectX::XMQuaternionNormalize(DirectX::XMQuaternionSlerp(
+                DirectX::XMVectorSet(a.orientation.x, a.orientation.y, a.orientation.z, a.orientation.w),
+                DirectX::XMVectorSet(b.orientation.x, b.orientation.y, b.orientation.z, b.orientation.w),
+                alpha));
+            const DirectX::XMVECTOR position =
+                DirectX::XMVectorLerp(DirectX::XMVectorSet(a.position.x, a.position.y, a.position.z, 0.f),
+                                      DirectX::XMVectorSet(b.position.x, b.position.y, b.position.z, 0.f),
+                                      alpha);
+
+            BodyTracking::Pose pose;
+            DirectX::XMStoreFloat4((DirectX::XMFLOAT4*)&pose.orientation, orientation);
+            DirectX::XMStoreFloat3((DirectX::XMFLOAT3*)&pose.position, position);
+            return pose;
+        }
+
+        // Integrate the velocities reported for a hand joint (both expressed in the tracking space).
+        static BodyTracking::Pose predictPose(const BodyTracking::FingerJointState& joint, float dt) {
+            BodyTracking::Pose pose = joint.Pose;
+            pose.position.x += joint.LinearVelocity.x * dt;
+            pose.position.y += joint.LinearVelocity.y * dt;
+            pose.position.z += joint.LinearVelocity.z * dt;
+
+            const DirectX::XMVECTOR angularVelocity =
+                DirectX::XMVectorSet(joint.AngularVelocity.x, joint.AngularVelocity.y, joint.AngularVelocity.z, 0.f);
+            const float angle = DirectX::XMVectorGetX(DirectX::XMVector3Length(angularVelocity)) * dt;
+            if (angle > FLT_EPSILON) {
+                const DirectX::XMVECTOR delta = DirectX::XMQuaternionRotationAxis(angularVelocity, angle);
+                DirectX::XMStoreFloat4(
+                    (DirectX::XMFLOAT4*)&pose.orientation,
+                    DirectX::XMQuaternionNormalize(DirectX::XMQuaternionMultiply(
+                        DirectX::XMVectorSet(
+                            pose.orientation.x, pose.orientation.y, pose.orientation.z, pose.orientation.w),
+                        delta)));
+            }
+            return pose;
+        }
+
+        static float lerp(float a, float b, float alpha) {
+            return a + (b - a) * alpha;
+        }
+
+        // Blend two consecutive samples. Discrete data (validity, flags, skeleton) is taken from the nearest sample,
+        // and continuous data is only blended when it is valid in both samples. An alpha above 1 extrapolates: poses
+        // keep their linear and angular velocities, and expression weights are clamped to their valid range.
+        // Confidences are interpolated but never extrapolated.
+        static void blend(const Sample& a,
+                          const Sample& b,
+                          double time,
+                          const PredictionLimits& limits,
+                          BodyTracking::BodyStateV2& state) {
+            const auto alphaAt = [&](double t) { return (float)((t - a.time) / (b.time - a.time)); };
+            const double jointsTime = std::min(time, b.time + limits.joints);
+            const float alpha = alphaAt(jointsTime);
+            const float eyesAlpha = alphaAt(std::min(time, b.time + limits.eyes));
+            const float faceAlpha = alphaAt(std::min(time, b.time + limits.face));
+            const float confidenceAlpha = std::min(alphaAt(time), 1.f);
+            const bool isExtrapolating = alpha > 1.f;
+            state = confidenceAlpha < 0.5f ? a.state : b.state;
+
+            if (a.state.FaceIsValid && b.state.FaceIsValid) {
+                for (uint32_t i = 0; i < BodyTracking::ExpressionCount; i++) {
+                    state.ExpressionWeights[i] = std::clamp(
+                        lerp(a.state.ExpressionWeights[i], b.state.ExpressionWeights[i], faceAlpha), 0.f, 1.f);
+                }
+                for (uint32_t i = 0; i < BodyTracking::ConfidenceCount; i++) {
+                    state.ExpressionConfidences[i] = lerp(
+                        a.state.ExpressionConfidences[i], b.state.ExpressionConfidences[i], confidenceAlpha);
+                }
+            }
+
+            if (a.state.LeftEyeIsValid && b.state.LeftEyeIsValid) {
+                state.LeftEyePose = blendPose(a.state.LeftEyePose, b.state.LeftEyePose, eyesAlpha);
+                state.LeftEyeConfidence = lerp(a.state.LeftEyeConfidence, b.state.LeftEyeConfidence, confidenceAlpha);
+            }
+            if (a.state.RightEyeIsValid && b.state.RightEyeIsValid) {
+                state.RightEyePose = blendPose(a.state.RightEyePose, b.state.RightEyePose, eyesAlpha);
+                state.RightEyeConfidence =
+                    lerp(a.state.RightEyeConfidence, b.state.RightEyeConfidence, confidenceAlpha);
+            }
+
+            const auto blendHand = [&](const BodyTracking::FingerJointState* jointsA,
+                                       const BodyTracking::FingerJointState* jointsB,
+                                       const BodyTracking::HandTrackingAimState& aimA,
+                                       const BodyTracking::HandTrackingAimState& aimB,
+                                       BodyTracking::FingerJointState* joints,
+                                       BodyTracking::HandTrackingAimState& aim) {
+                for (uint32_t i = 0; i < BodyTracking::HandJointCount; i++) {
+                    if (isExtrapolating) {
+                        // Prefer the velocities reported by the headset over finite differences.
+                        joints[i].Pose = predictPose(jointsB[i], (float)(jointsTime - b.time));
+                        continue;
+                    }
+
+                    joints[i].Pose = blendPose(jointsA[i].Pose, jointsB[i].Pose, alpha);
+                    joints[i].Radius = lerp(jointsA[i].Radius, jointsB[i].Radius, alpha);
+                    joints[i].AngularVelocity = {
+                        lerp(jointsA[i].AngularVelocity.x, jointsB[i].AngularVelocity.x, alpha),
+                        lerp(jointsA[i].AngularVelocity.y, jointsB[i].AngularVelocity.y, alpha),
+                        lerp(jointsA[i].AngularVelocity.z, jointsB[i].AngularVelocity.z, alpha)};
+                    joints[i].LinearVelocity = {lerp(jointsA[i].LinearVelocity.x, jointsB[i].LinearVelocity.x, alpha),
+                                                lerp(jointsA[i].LinearVelocity.y, jointsB[i].LinearVelocity.y, alpha),
+                                                lerp(jointsA[i].LinearVelocity.z, jointsB[i].LinearVelocity.z, alpha)};
+                }
+
+                if ((aimA.AimStatus & aimB.AimStatus & XR_HAND_TRACKING_AIM_VALID_BIT_FB)) {
+                    aim.AimPose = blendPose(aimA.AimPose, aimB.AimPose, alpha);
+                    aim.PinchStrengthIndex =
+                        std::clamp(lerp(aimA.PinchStrengthIndex, aimB.PinchStrengthIndex, alpha), 0.f, 1.f);
+                    aim.PinchStrengthMiddle =
+                        std::clamp(lerp(aimA.PinchStrengthMiddle, aimB.PinchStrengthMiddle, alpha), 0.f, 1.f);
+                    aim.PinchStrengthRing =
+                        std::clamp(lerp(aimA.PinchStrengthRing, aimB.PinchStrengthRing, alpha), 0.f, 1.f);
+                    aim.PinchStrengthLittle =
+                        std::clamp(lerp(aimA.PinchStrengthLittle, aimB.PinchStrengthLittle, alpha), 0.f, 1.f);
+                }
+            };
+            if (a.state.LeftHandActive && b.state.LeftHandActive) {
+                blendHand(a.state.LeftHandJointStates,
+                          b.state.LeftHandJointStates,
+                          a.state.LeftAimState,
+                          b.state.LeftAimState,
+                          state.LeftHandJointStates,
+                          state.LeftAimState);
+            }
+            if (a.state.RightHandActive && b.state.RightHandActive) {
+                blendHand(a.state.RightHandJointStates,
+                          b.state.RightHandJointStates,
+                          a.state.RightAimState,
+                          b.state.RightAimState,
+                          state.RightHandJointStates,
+                          state.RightAimState);
+            }
+
+            if (a.state.BodyTrackingConfidence > 0.f && b.state.BodyTrackingConfidence > 0.f) {
+                state.BodyTrackingConfidence =
+                    lerp(a.state.BodyTrackingConfidence, b.state.BodyTrackingConfidence, confidenceAlpha);
+                static constexpr uint64_t ValidFlags =
+                    XR_SPACE_LOCATION_ORIENTATION_VALID_BIT | XR_SPACE_LOCATION_POSITION_VALID_BIT;
+                for (uint32_t i = 0; i < BodyTracking::FullBodyJointCount; i++) {
+                    if ((a.state.BodyJoints[i].LocationFlags & b.state.BodyJoints[i].LocationFlags & ValidFlags) ==
+                        ValidFlags) {
+                        state.BodyJoints[i].Pose =
+                            blendPose(a.state.BodyJoints[i].Pose, b.state.BodyJoints[i].Pose, alpha);
+                    }
+                }
+            }
+        }
+
+        Slot m_slots[k_capacity];
+        std::atomic<uint64_t> m_writeCount{0};
+    };
+
+} // namespace virtualdesktop_openxr::utils
@@ -161,16 +161,17 @@ namespace virtualdesktop_openxr {
         const auto flags = locateSpaceToOrigin(xrBaseSpace, locateInfo->time, baseSpaceToVirtual, nullptr, nullptr);
 
         {
-            std::shared_lock lock(m_bodyStateMutex);
+            BodyTracking::BodyStateV2 bodyState{};
+            const bool hasBodyState = getBodyState(locateInfo->time, bodyState);
 
             // Check the hand state.
-            if (m_bodyState && m_cachedBodyState.BodyTrackingConfidence > 0.f) {
-                const BodyTracking::BodyJointLocation* const joints = m_cachedBodyState.BodyJoints;
+            if (hasBodyState && bodyState.BodyTrackingConfidence > 0.f) {
+                const BodyTracking::BodyJointLocation* const joints = bodyState.BodyJoints;
 
                 TraceLoggingWrite(
                     g_traceProvider,
                     "xrLocateBodyJointsFB",
-                    TLArg(m_cachedBodyState.BodyTrackingConfidence, "BodyTrackingConfidence"),
+                    TLArg(bodyState.BodyTrackingConfidence, "BodyTrackingConfidence"),
                     TLArg(joints[XR_FULL_BODY_JOINT_ROOT_META].LocationFlags, "RootLocationFlags"),
                     TLArg(xr::ToString(joints[XR_FULL_BODY_JOINT_ROOT_META].Pose).c_str(), "Root"),
                     TLArg(joints[XR_FULL_BODY_JOINT_HIPS_META].LocationFlags, "HipsLocationFlags"),
@@ -191,7 +192,7 @@ namespace virtualdesktop_openxr {
             } else {
                 TraceLoggingWrite(g_traceProvider,
                                   "xrLocateBodyJointsFB",
-                                  TLArg(m_cachedBodyState.BodyTrackingConfidence, "BodyTrackingConfidence"));
+                                  TLArg(bodyState.BodyTrackingConfidence, "BodyTrackingConfidence"));
 
                 locations->isActive = XR_FALSE;
             }
@@ -199,7 +200,7 @@ namespace virtualdesktop_openxr {
             // Report the fidelity.
             if (has_XR_META_body_tracking_fidelity && fidelityStatus) {
                 fidelityStatus->fidelity = (xrBodyTracker.maxFidelity == XR_BODY_TRACKING_FIDELITY_HIGH_META &&
-                                            m_cachedBodyState.BodyTrackingHighFidelity)
+                                            bodyState.BodyTrackingHighFidelity)
                                                ? XR_BODY_TRACKING_FIDELITY_HIGH_META
                                                : XR_BODY_TRACKING_FIDELITY_LOW_META;
             }
@@ -218,31 +219,26 @@ namespace virtualdesktop_openxr {
 
             // Virtual Desktop queries the joints in local or stage space depending on whether Stage Tracking is
             // enabled. We need to offset to the virtual space.
-            assert(ovr_GetTrackingOriginType(m_ovrSession) == ovrTrackingOrigin_FloorLevel);
-            const float floorHeight = ovr_GetFloat(m_ovrSession, OVR_KEY_EYE_HEIGHT, OVR_DEFAULT_EYE_HEIGHT);
+            ovrTrackingOrigin originType;
+            float floorHeight;
+            getTrackingOrigin(locateInfo->time, originType, floorHeight);
+            assert(originType == ovrTrackingOrigin_FloorLevel);
             TraceLoggingWrite(g_traceProvider, "OVR_GetConfig", TLArg(floorHeight, "EyeHeight"));
             const XrPosef jointsToVirtual =
                 (std::abs(floorHeight) >= FLT_EPSILON) ? Pose::Translation({0, floorHeight, 0}) : Pose::Identity();
             const XrPosef basePose = Pose::Multiply(jointsToVirtual, Pose::Invert(baseSpaceToVirtual));
 
-            locations->confidence = m_cachedBodyState.BodyTrackingConfidence;
+            locations->confidence = bodyState.BodyTrackingConfidence;
             for (uint32_t i = 0; i < locations->jointCount; i++) {
-                locations->jointLocations[i].locationFlags = m_cachedBodyState.BodyJoints[i].LocationFlags;
-                if (Pose::IsPoseValid(locations->jointLocations[i].locationFlags)) {
-                    const XrPosef poseOfBodyJoint = Pose::Multiply(
-                        xr::math::Pose::MakePose(XrQuaternionf{m_cachedBodyState.BodyJoints[i].Pose.orientation.x,
-                                                               m_cachedBodyState.BodyJoints[i].Pose.orientation.y,
-                                                               m_cachedBodyState.BodyJoints[i].Pose.orientation.z,
-                                                               m_cachedBodyState.BodyJoints[i].Pose.orientation.w},
-                                                 XrVector3f{m_cachedBodyState.BodyJoints[i].Pose.position.x,
-                                                            m_cachedBodyState.BodyJoints[i].Pose.position.y,
-                                                            m_cachedBodyState.BodyJoints[i].Pose.position.z}),
-                        basePose);
-
-                    locations->jointLocations[i].pose =
-                        Pose::Multiply(poseOfBodyJoint, Pose::Invert(baseSpaceToVirtual));
-                }
+                locations->jointLocations[i].locationFlags = bodyState.BodyJoints[i].LocationFlags;
+            }
+            // Both transforms are common to all joints, so combine them before the batch.
+            TransformJointPoses(Pose::Multiply(basePose, Pose::Invert(baseSpaceToVirtual)),
+                                bodyState.BodyJoints,
+                                locations->jointLocations,
+                                locations->jointCount);
 
+            for (uint32_t i = 0; i < locations->jointCount; i++) {
                 TraceLoggingWrite(g_traceProvider,
                                   "xrLocateBodyJointsFB",
                                   TLArg(i, "JointIndex"),
@@ -250,7 +246,7 @@ namespace virtualdesktop_openxr {
                                   TLArg(xr::ToString(locations->jointLocations[i].pose).c_str(), "Pose"));
             }
 
-            locations->skeletonChangedCount = m_cachedBodyState.SkeletonChangedCount;
+            locations->skeletonChangedCount = bodyState.SkeletonChangedCount;
         }
 
         return XR_SUCCESS;
@@ -285,20 +281,19 @@ namespace virtualdesktop_openxr {
         }
 
         // Forward the state from the memory mapped file.
-        if (m_bodyState) {
-            std::shared_lock lock(m_bodyStateMutex);
-
+        BodyTracking::BodyStateV2 bodyState{};
+        if (getLatestBodyState(bodyState)) {
             for (uint32_t i = 0; i < skeleton->jointCount; i++) {
-                skeleton->joints[i].joint = m_cachedBodyState.SkeletonJoints[i].Joint;
-                skeleton->joints[i].parentJoint = m_cachedBodyState.SkeletonJoints[i].ParentJoint;
+                skeleton->joints[i].joint = bodyState.SkeletonJoints[i].Joint;
+                skeleton->joints[i].parentJoint = bodyState.SkeletonJoints[i].ParentJoint;
                 skeleton->joints[i].pose =
-                    xr::math::Pose::MakePose(XrQuaternionf{m_cachedBodyState.SkeletonJoints[i].Pose.orientation.x,
-                                                           m_cachedBodyState.SkeletonJoints[i].Pose.orientation.y,
-                                                           m_cachedBodyState.SkeletonJoints[i].Pose.orientation.z,
-                                                           m_cachedBodyState.SkeletonJoints[i].Pose.orientation.w},
-                                             XrVector3f{m_cachedBodyState.SkeletonJoints[i].Pose.position.x,
-                                                        m_cachedBodyState.SkeletonJoints[i].Pose.position.y,
-                                                        m_cachedBodyState.SkeletonJoints[i].Pose.position.z});
+                    xr::math::Pose::MakePose(XrQuaternionf{bodyState.SkeletonJoints[i].Pose.orientation.x,
+                                                           bodyState.SkeletonJoints[i].Pose.orientation.y,
+                                                           bodyState.SkeletonJoints[i].Pose.orientation.z,
+                                                           bodyState.SkeletonJoints[i].Pose.orientation.w},
+                                             XrVector3f{bodyState.SkeletonJoints[i].Pose.position.x,
+                                                        bodyState.SkeletonJoints[i].Pose.position.y,
+                                                        bodyState.SkeletonJoints[i].Pose.position.z});
             }
         } else {
             for (uint32_t i = 0; i < skeleton->jointCount; i++) {
@@ -406,7 +401,7 @@ namespace virtualdesktop_openxr {
         return XR_SUCCESS;
     }
 
-    int OpenXrRuntime::getTrackerIndex(const std::string& path) const {
+    int OpenXrRuntime::getTrackerIndex(std::string_view path) const {
         if (!m_supportsBodyTracking || !m_emulateViveTrackers) {
             return -1;
         }
@@ -452,16 +447,17 @@ namespace virtualdesktop_openxr {
     }
 
     XrSpaceLocationFlags OpenXrRuntime::getBodyJointPose(XrFullBodyJointMETA joint, XrTime time, XrPosef& pose) const {
-        std::shared_lock lock(m_bodyStateMutex);
+        BodyTracking::BodyStateV2 bodyState{};
+        getBodyState(time, bodyState);
 
         TraceLoggingWrite(g_traceProvider,
                           "VirtualDesktopBodyTracker",
-                          TLArg(m_cachedBodyState.BodyTrackingConfidence, "BodyTrackingConfidence"));
-        if (!m_cachedBodyState.BodyTrackingConfidence) {
+                          TLArg(bodyState.BodyTrackingConfidence, "BodyTrackingConfidence"));
+        if (!bodyState.BodyTrackingConfidence) {
             return 0;
         }
 
-        const BodyTracking::BodyJointLocation& location = m_cachedBodyState.BodyJoints[joint];
+        const BodyTracking::BodyJointLocation& location = bodyState.BodyJoints[joint];
         TraceLoggingWrite(g_traceProvider,
                           "VirtualDesktopBodyTracker",
                           TLArg((int)joint, "JointIndex"),
@@ -472,8 +468,10 @@ namespace virtualdesktop_openxr {
 
         // Virtual Desktop queries the joints in local or stage space depending on whether Stage Tracking is
         // enabled. We need to offset to the virtual space.
-        assert(ovr_GetTrackingOriginType(m_ovrSession) == ovrTrackingOrigin_FloorLevel);
-        const float floorHeight = ovr_GetFloat(m_ovrSession, OVR_KEY_EYE_HEIGHT, OVR_DEFAULT_EYE_HEIGHT);
+        ovrTrackingOrigin originType;
+        float floorHeight;
+        getTrackingOrigin(time, originType, floorHeight);
+        assert(originType == ovrTrackingOrigin_FloorLevel);
         TraceLoggingWrite(g_traceProvider, "OVR_GetConfig", TLArg(floorHeight, "EyeHeight"));
         const XrPosef jointsToVirtual =
             (std::abs(floorHeight) >= FLT_EPSILON) ? Pose::Translation({0, floorHeight, 0}) : Pose::Identity();
@@ -26,6 +26,7 @@
 #include "runtime.h"
 #include "utils.h"
 
+#include "AlphaBlending8x8CS.h"
 #include "AlphaBlendingCS.h"
 #include "FullScreenQuadVS.h"
 #include "ResolveMultisampledDepthPS.h"
@@ -46,6 +47,8 @@ namespace virtualdesktop_openxr {
     struct AlphaBlendingCSConstants {
         alignas(4) bool ignoreAlpha;
         alignas(4) bool isUnpremultipliedAlpha;
+        alignas(4) uint32_t offset[2];
+        alignas(4) uint32_t extent[2];
     };
 
     // https://www.khronos.org/registry/OpenXR/specs/1.0/html/xrspec.html#xrGetD3D11GraphicsRequirementsKHR
@@ -220,8 +223,15 @@ namespace virtualdesktop_openxr {
         m_fenceValue = 0;
 
         // Create the resources for pre-processing.
-        CHECK_HRCMD(m_ovrSubmissionDevice->CreateComputeShader(
-            g_AlphaBlendingCS, sizeof(g_AlphaBlendingCS), nullptr, m_alphaCorrectShader.ReleaseAndGetAddressOf()));
+        if (!m_useSmallAlphaCorrectionGroups) {
+            CHECK_HRCMD(m_ovrSubmissionDevice->CreateComputeShader(
+                g_AlphaBlendingCS, sizeof(g_AlphaBlendingCS), nullptr, m_alphaCorrectShader.ReleaseAndGetAddressOf()));
+        } else {
+            CHECK_HRCMD(m_ovrSubmissionDevice->CreateComputeShader(g_AlphaBlending8x8CS,
+                                                                   sizeof(g_AlphaBlending8x8CS),
+                                                                   nullptr,
+                                                                   m_alphaCorrectShader.ReleaseAndGetAddressOf()));
+        }
         setDebugName(m_alphaCorrectShader.Get(), "AlphaBlending CS");
         CHECK_HRCMD(m_ovrSubmissionDevice->CreateVertexShader(
             g_FullScreenQuadVS, sizeof(g_FullScreenQuadVS), nullptr, m_fullQuadVS.ReleaseAndGetAddressOf()));
@@ -351,6 +361,7 @@ namespace virtualdesktop_openxr {
         m_resolveMultisampledDepthConstants.Reset();
         m_alphaCorrectShader.Reset();
         m_alphaCorrectConstants.Reset();
+        m_viewCache.clear();
         m_linearClampSampler.Reset();
         m_pointClampSampler.Reset();
         m_noDepthReadState.Reset();
@@ -533,15 +544,16 @@ namespace virtualdesktop_openxr {
     void OpenXrRuntime::preprocessSwapchainImage(Swapchain& xrSwapchain,
                                                  uint32_t layerIndex,
                                                  uint32_t slice,
+                                                 const XrRect2Di* imageRect,
                                                  XrCompositionLayerFlags compositionFlags,
-                                                 std::set<std::pair<Swapchain*, uint32_t>>& processed) {
+                                                 ArenaVector<std::pair<Swapchain*, uint32_t>>& processed) {
         ensureSwapchainSliceResources(xrSwapchain, slice);
 
         // If the texture was never used or already committed, do nothing.
-        // TODO: If the same swapchain is used with different bits in several layers, the bits are not honored. This is
-        // a very uncommon case.
+        // TODO: If the same swapchain is used with different bits or image rects in several layers, the bits and rects
+        // of the first layer win. This is a very uncommon case.
         const auto tuple = std::make_pair(&xrSwapchain, slice);
-        if (xrSwapchain.appSwapchain.images.empty() || processed.count(tuple)) {
+        if (xrSwapchain.appSwapchain.images.empty() || processed.contains(tuple)) {
             return;
         }
 
@@ -563,28 +575,42 @@ namespace virtualdesktop_openxr {
                           TLArg(needPremultiplyAlpha, "NeedPremultiplyAlpha"),
                           TLArg(needCopy, "NeedCopy"));
 
-        int ovrDestIndex = -1;
-        while (true) {
+        // If the application submits the same image again, there is no need to copy or process it again: the image
+        // previously committed to OVR is still valid.
+        const XrRect2Di fullImageRect{{0, 0}, {(int32_t)xrSwapchain.xrDesc.width, (int32_t)xrSwapchain.xrDesc.height}};
+        const PreprocessedImage preprocessed{
+            xrSwapchain.releaseCount, imageRect ? *imageRect : fullImageRect, needClearAlpha, needPremultiplyAlpha};
+        SwapchainSlice& resolvedSlice = xrSwapchain.resolvedSlices[slice];
+        if ((needCopy || needClearAlpha || needPremultiplyAlpha) && resolvedSlice.lastPreprocessed == preprocessed) {
+            TraceLoggingWrite(g_traceProvider, "PreprocessSwapchainImage_Skip");
+            processed.push_back(tuple);
+            return;
+        }
+
+        SwapchainIndexTracker& indexTracker = resolvedSlice.indexTracker;
+        if (!indexTracker.isSynchronized()) {
+            int ovrCurrentIndex = -1;
             CHECK_OVRCMD(ovr_GetTextureSwapChainCurrentIndex(
-                m_ovrSession, xrSwapchain.resolvedSlices[slice].ovrSwapchain, &ovrDestIndex));
+                m_ovrSession, xrSwapchain.resolvedSlices[slice].ovrSwapchain, &ovrCurrentIndex));
+            indexTracker.synchronize(xrSwapchain.ovrSwapchainLength, ovrCurrentIndex);
+        }
 
-            // If we can use the swapchain with LibOVR directly (without a copy), then let's commit to the swapchain
-            // until the last committed image matches the last released image index.
-            int ovrCommittedIndex = ovrDestIndex - 1;
-            if (ovrCommittedIndex < 0) {
-                ovrCommittedIndex = xrSwapchain.ovrSwapchainLength - 1;
-            }
-            if (needCopy) {
-                TraceLoggingWrite(g_traceProvider, "PreprocessSwapchainImage", TLArg(ovrDestIndex, "DestIndex"));
-                break;
-            }
-            TraceLoggingWrite(
-                g_traceProvider, "PreprocessSwapchainImage_SyncImage", TLArg(ovrCommittedIndex, "CommittedIndex"));
-            if (ovrCommittedIndex == lastReleasedIndex) {
-                break;
-            }
-            CHECK_OVRCMD(ovr_CommitTextureSwapChain(m_ovrSession, xrSwapchain.resolvedSlices[slice].ovrSwapchain));
+        // If we can use the swapchain with LibOVR directly (without a copy), then schedule the commits needed for the
+        // last committed image to match the last released image index. They are issued in commitSwapchainImages().
+        if (!needCopy) {
+            const int commits = indexTracker.present(lastReleasedIndex);
+            TraceLoggingWrite(g_traceProvider,
+                              "PreprocessSwapchainImage_SyncImage",
+                              TLArg(indexTracker.committedIndex(), "CommittedIndex"),
+                              TLArg(commits, "Commits"));
         }
+        const int ovrDestIndex = indexTracker.currentIndex();
+        if (needCopy) {
+            TraceLoggingWrite(g_traceProvider, "PreprocessSwapchainImage", TLArg(ovrDestIndex, "DestIndex"));
+        }
+
+        // The image that is going to be presented, either our copy or the application image itself.
+        const int processedIndex = needCopy ? ovrDestIndex : lastReleasedIndex;
 
         if (needCopy) {
             const bool isDepthBuffer =
@@ -626,37 +652,22 @@ namespace virtualdesktop_openxr {
                                                                        m_d3d11ContextState.ReleaseAndGetAddressOf());
                     }
 
-                    if (xrSwapchain.appSwapchain.srvs.size() <= lastReleasedIndex) {
-                        xrSwapchain.appSwapchain.srvs.resize(lastReleasedIndex + 1);
-                    }
-                    if (!xrSwapchain.appSwapchain.srvs[lastReleasedIndex]) {
+                    ComPtr<ID3D11ShaderResourceView> srv;
+                    {
                         D3D11_SHADER_RESOURCE_VIEW_DESC desc{};
                         desc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2DMSARRAY;
                         desc.Format = getShaderResourceViewFormat(xrSwapchain.dxgiFormatForSubmission);
                         desc.Texture2DMSArray.ArraySize = xrSwapchain.ovrDesc.ArraySize;
-                        CHECK_HRCMD(m_ovrSubmissionDevice->CreateShaderResourceView(
-                            xrSwapchain.appSwapchain.images[lastReleasedIndex].Get(),
-                            &desc,
-                            xrSwapchain.appSwapchain.srvs[lastReleasedIndex].ReleaseAndGetAddressOf()));
-                        setDebugName(
-                            xrSwapchain.appSwapchain.srvs[lastReleasedIndex].Get(),
-                            fmt::format(
-                                "Runtime Slice SRV[{}, {}, {}]", slice, lastReleasedIndex, (void*)&xrSwapchain));
+                        srv = getShaderResourceView(
+                            xrSwapchain.appSwapchain.images[lastReleasedIndex].Get(), desc, "Runtime Slice");
                     }
-                    if (xrSwapchain.resolvedSlices[slice].dsvs.size() <= ovrDestIndex) {
-                        xrSwapchain.resolvedSlices[slice].dsvs.resize(ovrDestIndex + 1);
-                    }
-                    if (!xrSwapchain.resolvedSlices[slice].dsvs[ovrDestIndex]) {
+                    ComPtr<ID3D11DepthStencilView> dsv;
+                    {
                         D3D11_DEPTH_STENCIL_VIEW_DESC desc{};
                         desc.ViewDimension = D3D11_DSV_DIMENSION_TEXTURE2D;
                         desc.Format = xrSwapchain.dxgiFormatForSubmission;
-                        CHECK_HRCMD(m_ovrSubmissionDevice->CreateDepthStencilView(
-                            xrSwapchain.resolvedSlices[slice].images[ovrDestIndex].Get(),
-                            &desc,
-                            xrSwapchain.resolvedSlices[slice].dsvs[ovrDestIndex].ReleaseAndGetAddressOf()));
-                        setDebugName(
-                            xrSwapchain.resolvedSlices[slice].dsvs[ovrDestIndex].Get(),
-                            fmt::format("Runtime Slice DSV[{}, {}, {}]", slice, ovrDestIndex, (void*)&xrSwapchain));
+                        dsv = getDepthStencilView(
+                            xrSwapchain.resolvedSlices[slice].images[ovrDestIndex].Get(), desc, "Runtime Slice");
                     }
 
                     m_ovrSubmissionContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP);
@@ -664,8 +675,7 @@ namespace virtualdesktop_openxr {
                     m_ovrSubmissionContext->VSSetShader(m_fullQuadVS.Get(), nullptr, 0);
                     m_ovrSubmissionContext->PSSetShader(m_resolveMultisampledDepthPS.Get(), nullptr, 0);
 
-                    m_ovrSubmissionContext->OMSetRenderTargets(
-                        0, nullptr, xrSwapchain.resolvedSlices[slice].dsvs[ovrDestIndex].Get());
+                    m_ovrSubmissionContext->OMSetRenderTargets(0, nullptr, dsv.Get());
                     D3D11_VIEWPORT viewport{};
                     viewport.Width = (float)xrSwapchain.ovrDesc.Width;
                     viewport.Height = (float)xrSwapchain.ovrDesc.Height;
@@ -689,7 +699,7 @@ namespace virtualdesktop_openxr {
                     }
                     ID3D11SamplerState* sampler[] = {m_pointClampSampler.Get()};
                     m_ovrSubmissionContext->PSSetSamplers(0, 1, sampler);
-                    ID3D11ShaderResourceView* SRV[] = {xrSwapchain.appSwapchain.srvs[lastReleasedIndex].Get()};
+                    ID3D11ShaderResourceView* SRV[] = {srv.Get()};
                     m_ovrSubmissionContext->PSSetShaderResources(0, 1, SRV);
 
                     m_ovrSubmissionContext->Draw(3, 0);
@@ -710,7 +720,15 @@ namespace virtualdesktop_openxr {
             }
         }
 
-        if (needClearAlpha || needPremultiplyAlpha) {
+        // Only process the region of the image that is visible in the layer.
+        const uint32_t alphaCorrectGroupSize = m_useSmallAlphaCorrectionGroups ? 8 : 32;
+        const auto alphaCorrectDispatch = needClearAlpha || needPremultiplyAlpha
+                                              ? PlanAlphaCorrectionDispatch(preprocessed.imageRect,
+                                                                            xrSwapchain.xrDesc.width,
+                                                                            xrSwapchain.xrDesc.height,
+                                                                            alphaCorrectGroupSize)
+                                              : std::nullopt;
+        if (alphaCorrectDispatch) {
             // Circumvent some of OVR's limitations:
             // - For alpha-blended layers, we must pre-process the alpha channel.
 
@@ -726,6 +744,10 @@ namespace virtualdesktop_openxr {
                 AlphaBlendingCSConstants constants{};
                 constants.ignoreAlpha = needClearAlpha;
                 constants.isUnpremultipliedAlpha = needPremultiplyAlpha;
+                constants.offset[0] = alphaCorrectDispatch->offset[0];
+                constants.offset[1] = alphaCorrectDispatch->offset[1];
+                constants.extent[0] = alphaCorrectDispatch->extent[0];
+                constants.extent[1] = alphaCorrectDispatch->extent[1];
 
                 D3D11_MAPPED_SUBRESOURCE mappedResources;
                 CHECK_HRCMD(m_ovrSubmissionContext->Map(
@@ -735,26 +757,22 @@ namespace virtualdesktop_openxr {
                 m_ovrSubmissionContext->CSSetConstantBuffers(0, 1, m_alphaCorrectConstants.GetAddressOf());
             }
 
-            if (xrSwapchain.resolvedSlices[slice].uavs.size() <= ovrDestIndex) {
-                xrSwapchain.resolvedSlices[slice].uavs.resize(ovrDestIndex + 1);
-            }
-            if (!xrSwapchain.resolvedSlices[slice].uavs[ovrDestIndex]) {
+            ComPtr<ID3D11UnorderedAccessView> uav;
+            {
                 D3D11_UNORDERED_ACCESS_VIEW_DESC desc{};
                 desc.ViewDimension = D3D11_UAV_DIMENSION_TEXTURE2D;
                 desc.Format = getUnorderedAccessViewFormat(xrSwapchain.dxgiFormatForSubmission);
-                CHECK_HRCMD(m_ovrSubmissionDevice->CreateUnorderedAccessView(
-                    xrSwapchain.resolvedSlices[slice].images[ovrDestIndex].Get(),
-                    &desc,
-                    xrSwapchain.resolvedSlices[slice].uavs[ovrDestIndex].ReleaseAndGetAddressOf()));
-                setDebugName(xrSwapchain.resolvedSlices[slice].uavs[ovrDestIndex].Get(),
-                             fmt::format("Runtime Slice UAV[{}, {}, {}]", slice, ovrDestIndex, (void*)&xrSwapchain));
+                uav = getUnorderedAccessView(resolvedSlice.images[processedIndex].Get(), desc, "Runtime Slice");
             }
-            m_ovrSubmissionContext->CSSetUnorderedAccessViews(
-                0, 1, xrSwapchain.resolvedSlices[slice].uavs[ovrDestIndex].GetAddressOf(), nullptr);
+            m_ovrSubmissionContext->CSSetUnorderedAccessViews(0, 1, uav.GetAddressOf(), nullptr);
 
-            m_ovrSubmissionContext->Dispatch((unsigned int)std::ceil(xrSwapchain.xrDesc.width / 32),
-                                             (unsigned int)std::ceil(xrSwapchain.xrDesc.height / 32),
-                                             1);
+            TraceLoggingWrite(g_traceProvider,
+                              "PreprocessSwapchainImage_AlphaCorrect",
+                              TLArg(processedIndex, "Index"),
+                              TLArg(alphaCorrectDispatch->groupCount[0], "GroupCountX"),
+                              TLArg(alphaCorrectDispatch->groupCount[1], "GroupCountY"));
+            m_ovrSubmissionContext->Dispatch(
+                alphaCorrectDispatch->groupCount[0], alphaCorrectDispatch->groupCount[1], 1);
 
             // Unbind all resources to avoid D3D validation errors.
             {
@@ -768,9 +786,59 @@ namespace virtualdesktop_openxr {
 
         if (needCopy) {
             // Commit the texture to OVR if using a different swapchain.
-            CHECK_OVRCMD(ovr_CommitTextureSwapChain(m_ovrSession, xrSwapchain.resolvedSlices[slice].ovrSwapchain));
+            indexTracker.present(ovrDestIndex);
+        }
+        resolvedSlice.lastPreprocessed = preprocessed;
+        processed.push_back(tuple);
+    }
+
+    // Issue the commits scheduled by preprocessSwapchainImage() for all the layers of the frame.
+    void OpenXrRuntime::commitSwapchainImages(const ArenaVector<std::pair<Swapchain*, uint32_t>>& processed) {
+        for (const auto& [xrSwapchain, slice] : processed) {
+            SwapchainSlice& resolvedSlice = xrSwapchain->resolvedSlices[slice];
+            const int commits = resolvedSlice.indexTracker.takePendingCommits();
+            if (!commits) {
+                continue;
+            }
+
+            for (int i = 0; i < commits; i++) {
+                const ovrResult result = ovr_CommitTextureSwapChain(m_ovrSession, resolvedSlice.ovrSwapchain);
+                if (OVR_FAILURE(result)) {
+                    // We do not know how many commits took effect. Make every slice of the frame resynchronize with
+                    // LibOVR at the next frame, including those whose pending commits will never be issued.
+                    for (const auto& [otherSwapchain, otherSlice] : processed) {
+                        otherSwapchain->resolvedSlices[otherSlice].indexTracker.invalidate();
+                    }
+                    CHECK_OVRCMD(result);
+                }
+            }
+
+            // Catch any commit that we did not account for (or that did not take effect). The model is resynchronized
+            // and the image will be presented correctly at the next frame.
+            int ovrCurrentIndex = -1;
+            const ovrResult result =
+                ovr_GetTextureSwapChainCurrentIndex(m_ovrSession, resolvedSlice.ovrSwapchain, &ovrCurrentIndex);
+            if (OVR_FAILURE(result)) {
+                resolvedSlice.indexTracker.invalidate();
+                CHECK_OVRCMD(result);
+            }
+            const int expectedIndex = resolvedSlice.indexTracker.currentIndex();
+            if (!resolvedSlice.indexTracker.verify(ovrCurrentIndex)) {
+                ErrorLog("Swapchain %p slice %u is out of sync (expected index %d, got %d)\n",
+                         xrSwapchain,
+                         slice,
+                         expectedIndex,
+                         ovrCurrentIndex);
+            }
+
+            TraceLoggingWrite(g_traceProvider,
+                              "CommitSwapchainImages",
+                              TLPArg(xrSwapchain, "Swapchain"),
+                              TLArg(slice, "Slice"),
+                              TLArg(commits, "Commits"),
+                              TLArg(ovrCurrentIndex, "CurrentIndex"),
+                              TLArg(expectedIndex, "ExpectedIndex"));
         }
-        processed.insert(tuple);
     }
 
     // Ensure necessary resources for submission: lazily create a second swapchain for this slice of the array or
@@ -808,17 +876,6 @@ namespace virtualdesktop_openxr {
                 desc.Format = isSRGBFormat((DXGI_FORMAT)xrSwapchain.xrDesc.format) ? OVR_FORMAT_B8G8R8A8_UNORM_SRGB
                                                                                    : OVR_FORMAT_B8G8R8A8_UNORM;
                 populateSwapchainSlice(xrSwapchain, desc, xrSwapchain.stereoProjection[eye], eye, "Precompositor");
-
-                for (uint32_t i = 0; i < xrSwapchain.stereoProjection[eye].images.size(); i++) {
-                    D3D11_RENDER_TARGET_VIEW_DESC desc{};
-                    desc.ViewDimension = D3D11_RTV_DIMENSION_TEXTURE2D;
-                    desc.Format = xrSwapchain.dxgiFormatForSubmission;
-                    ComPtr<ID3D11RenderTargetView> rtv;
-                    CHECK_HRCMD(m_ovrSubmissionDevice->CreateRenderTargetView(
-                        xrSwapchain.stereoProjection[eye].images[i].Get(), &desc, rtv.ReleaseAndGetAddressOf()));
-                    setDebugName(rtv.Get(), fmt::format("Precompositor RTV [{}, {}, {}]", eye, i, (void*)&xrSwapchain));
-                    xrSwapchain.stereoProjection[eye].rtvs.push_back(std::move(rtv));
-                }
             }
         }
     }
@@ -850,6 +907,109 @@ namespace virtualdesktop_openxr {
         }
     }
 
+    // Identify the views for the view cache. Only the dimensions used by the runtime carry a mip or array slice.
+    static ViewKey getViewKey(ID3D11Texture2D* texture, const D3D11_SHADER_RESOURCE_VIEW_DESC& desc) {
+        ViewKey key{texture, ViewType::ShaderResource, (uint32_t)desc.ViewDimension, (uint32_t)desc.Format, 0, 0, 0};
+        if (desc.ViewDimension == D3D11_SRV_DIMENSION_TEXTURE2D) {
+            key.mipSlice = desc.Texture2D.MostDetailedMip;
+        } else if (desc.ViewDimension == D3D11_SRV_DIMENSION_TEXTURE2DARRAY) {
+            key.mipSlice = desc.Texture2DArray.MostDetailedMip;
+            key.firstArraySlice = desc.Texture2DArray.FirstArraySlice;
+            key.arraySize = desc.Texture2DArray.ArraySize;
+        } else if (desc.ViewDimension == D3D11_SRV_DIMENSION_TEXTURE2DMSARRAY) {
+            key.firstArraySlice = desc.Texture2DMSArray.FirstArraySlice;
+            key.arraySize = desc.Texture2DMSArray.ArraySize;
+        }
+        return key;
+    }
+
+    static ViewKey getViewKey(ID3D11Texture2D* texture, const D3D11_UNORDERED_ACCESS_VIEW_DESC& desc) {
+        ViewKey key{texture, ViewType::UnorderedAccess, (uint32_t)desc.ViewDimension, (uint32_t)desc.Format, 0, 0, 0};
+        if (desc.ViewDimension == D3D11_UAV_DIMENSION_TEXTURE2D) {
+            key.mipSlice = desc.Texture2D.MipSlice;
+        } else if (desc.ViewDimension == D3D11_UAV_DIMENSION_TEXTURE2DARRAY) {
+            key.mipSlice = desc.Texture2DArray.MipSlice;
+            key.firstArraySlice = desc.Texture2DArray.FirstArraySlice;
+            key.arraySize = desc.Texture2DArray.ArraySize;
+        }
+        return key;
+    }
+
+    static ViewKey getViewKey(ID3D11Texture2D* texture, const D3D11_DEPTH_STENCIL_VIEW_DESC& desc) {
+        ViewKey key{texture, ViewType::DepthStencil, (uint32_t)desc.ViewDimension, (uint32_t)desc.Format, 0, 0, 0};
+        if (desc.ViewDimension == D3D11_DSV_DIMENSION_TEXTURE2D) {
+            key.mipSlice = desc.Texture2D.MipSlice;
+        } else if (desc.ViewDimension == D3D11_DSV_DIMENSION_TEXTURE2DARRAY) {
+            key.mipSlice = desc.Texture2DArray.MipSlice;
+            key.firstArraySlice = desc.Texture2DArray.FirstArraySlice;
+            key.arraySize = desc.Texture2DArray.ArraySize;
+        } else if (desc.ViewDimension == D3D11_DSV_DIMENSION_TEXTURE2DMSARRAY) {
+            key.firstArraySlice = desc.Texture2DMSArray.FirstArraySlice;
+            key.arraySize = desc.Texture2DMSArray.ArraySize;
+        }
+        return key;
+    }
+
+    // Retrieve a view from the view cache, or create it.
+    ComPtr<ID3D11ShaderResourceView> OpenXrRuntime::getShaderResourceView(ID3D11Texture2D* texture,
+                                                                          const D3D11_SHADER_RESOURCE_VIEW_DESC& desc,
+                                                                          const char* debugName) const {
+        ComPtr<ID3D11View> view = m_viewCache.get(getViewKey(texture, desc), [&]() {
+            ComPtr<ID3D11ShaderResourceView> srv;
+            CHECK_HRCMD(m_ovrSubmissionDevice->CreateShaderResourceView(texture, &desc, srv.ReleaseAndGetAddressOf()));
+            setDebugName(srv.Get(), fmt::format("{} SRV[{}]", debugName, (void*)texture));
+            return ComPtr<ID3D11View>(srv);
+        });
+        return static_cast<ID3D11ShaderResourceView*>(view.Get());
+    }
+
+    ComPtr<ID3D11UnorderedAccessView>
+    OpenXrRuntime::getUnorderedAccessView(ID3D11Texture2D* texture,
+                                          const D3D11_UNORDERED_ACCESS_VIEW_DESC& desc,
+                                          const char* debugName) const {
+        ComPtr<ID3D11View> view = m_viewCache.get(getViewKey(texture, desc), [&]() {
+            ComPtr<ID3D11UnorderedAccessView> uav;
+            CHECK_HRCMD(m_ovrSubmissionDevice->CreateUnorderedAccessView(texture, &desc, uav.ReleaseAndGetAddressOf()));
+            setDebugName(uav.Get(), fmt::format("{} UAV[{}]", debugName, (void*)texture));
+            return ComPtr<ID3D11View>(uav);
+        });
+        return static_cast<ID3D11UnorderedAccessView*>(view.Get());
+    }
+
+    ComPtr<ID3D11DepthStencilView> OpenXrRuntime::getDepthStencilView(ID3D11Texture2D* texture,
+                                                                      const D3D11_DEPTH_STENCIL_VIEW_DESC& desc,
+                                                                      const char* debugName) const {
+        ComPtr<ID3D11View> view = m_viewCache.get(getViewKey(texture, desc), [&]() {
+            ComPtr<ID3D11DepthStencilView> dsv;
+            CHECK_HRCMD(m_ovrSubmissionDevice->CreateDepthStencilView(texture, &desc, dsv.ReleaseAndGetAddressOf()));
+            setDebugName(dsv.Get(), fmt::format("{} DSV[{}]", debugName, (void*)texture));
+            return ComPtr<ID3D11View>(dsv);
+        });
+        return static_cast<ID3D11DepthStencilView*>(view.Get());
+    }
+
+    // Drop the cached views of the swapchain textures, since they hold references to the textures.
+    void OpenXrRuntime::evictSwapchainViews(const Swapchain& xrSwapchain) {
+        std::unordered_set<const void*> textures;
+        const auto addSlice = [&](const SwapchainSlice& slice) {
+            for (const auto& image : slice.images) {
+                textures.insert(image.Get());
+            }
+        };
+        addSlice(xrSwapchain.appSwapchain);
+        for (const auto& slice : xrSwapchain.resolvedSlices) {
+            addSlice(slice);
+        }
+        for (const auto& slice : xrSwapchain.stereoProjection) {
+            addSlice(slice);
+        }
+        for (const auto& image : xrSwapchain.d3d11Images) {
+            textures.insert(image.Get());
+        }
+
+        m_viewCache.evictIf([&](const ViewKey& key) { return textures.count(key.resource) != 0; });
+    }
+
     // Flush any pending work in the app context.
     void OpenXrRuntime::flushD3D11Context() {
         if (m_d3d11Context && m_d3d11Fence) {
@@ -880,13 +1040,20 @@ namespace virtualdesktop_openxr {
         }
     }
 
+    // Signal the next fence value from the app context, without waiting.
+    void OpenXrRuntime::signalD3D11Context() {
+        if (m_ovrSubmissionDevice != m_d3d11Device) {
+            m_fenceValue++;
+            CHECK_HRCMD(m_d3d11Context->Signal(m_d3d11Fence.Get(), m_fenceValue));
+        }
+    }
+
     // Serialize commands from the D3D12 queue to the D3D11 context used by OVR.
     void OpenXrRuntime::serializeD3D11Frame() {
         if (m_ovrSubmissionDevice != m_d3d11Device) {
-            m_fenceValue++;
+            signalD3D11Context();
             TraceLoggingWrite(
                 g_traceProvider, "xrEndFrame_Sync", TLArg("D3D11", "Api"), TLArg(m_fenceValue, "FenceValue"));
-            CHECK_HRCMD(m_d3d11Context->Signal(m_d3d11Fence.Get(), m_fenceValue));
 
             waitOnSubmissionDevice();
         }
@@ -258,11 +258,16 @@ namespace virtualdesktop_openxr {
         }
     }
 
+    // Signal the next fence value from the app queue, without waiting.
+    void OpenXrRuntime::signalD3D12CommandQueue() {
+        m_fenceValue++;
+        CHECK_HRCMD(m_d3d12CommandQueue->Signal(m_d3d12Fence.Get(), m_fenceValue));
+    }
+
     // Serialize commands from the D3D12 queue to the D3D11 context used by OVR.
     void OpenXrRuntime::serializeD3D12Frame() {
-        m_fenceValue++;
+        signalD3D12CommandQueue();
         TraceLoggingWrite(g_traceProvider, "xrEndFrame_Sync", TLArg("D3D12", "Api"), TLArg(m_fenceValue, "FenceValue"));
-        CHECK_HRCMD(m_d3d12CommandQueue->Signal(m_d3d12Fence.Get(), m_fenceValue));
 
         waitOnSubmissionDevice();
     }
@@ -0,0 +1,76 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "pch.h"
+
+namespace virtualdesktop_openxr::utils {
+
+    // A queue of objects whose release must wait for the GPU to be done with them. Each object is tagged with a fence
+    // value, and the objects are released in order once the fence reaches that value. Fence values are expected to be
+    // pushed in non-decreasing order.
+    template <typename T>
+    class DeferredReleaseQueue {
+      public:
+        void push(T object, uint64_t fenceValue) {
+            m_entries.push_back({std::move(object), fenceValue});
+        }
+
+        // Release the objects whose fence has completed. Returns the number of objects released.
+        template <typename Release>
+        size_t releaseCompleted(uint64_t completedFenceValue, Release&& release) {
+            size_t count = 0;
+            while (!m_entries.empty() && m_entries.front().fenceValue <= completedFenceValue) {
+                T object = std::move(m_entries.front().object);
+                m_entries.pop_front();
+                release(std::move(object));
+                count++;
+            }
+            return count;
+        }
+
+        // Release all the objects, regardless of their fence. The caller must have waited for the GPU to be idle.
+        template <typename Release>
+        size_t drain(Release&& release) {
+            return releaseCompleted(std::numeric_limits<uint64_t>::max(), std::forward<Release>(release));
+        }
+
+        size_t size() const {
+            return m_entries.size();
+        }
+
+        bool empty() const {
+            return m_entries.empty();
+        }
+
+      private:
+        struct Entry {
+            T object;
+            uint64_t fenceValue;
+        };
+
+        // Ordered from the oldest to the most recently pushed.
+        std::deque<Entry> m_entries;
+    };
+
+} // namespace virtualdesktop_openxr::utils
@@ -120,14 +120,13 @@ namespace virtualdesktop_openxr {
         }
 
         // Forward the state from the memory mapped file.
-        if (m_bodyState) {
-            std::shared_lock lock(m_bodyStateMutex);
+        BodyTracking::BodyStateV2 bodyState{};
+        if (getBodyState(gazeInfo->time, bodyState)) {
+            eyeGazes->gaze[xr::Side::Left].gazeConfidence = bodyState.LeftEyeConfidence;
+            eyeGazes->gaze[xr::Side::Right].gazeConfidence = bodyState.RightEyeConfidence;
 
-            eyeGazes->gaze[xr::Side::Left].gazeConfidence = m_cachedBodyState.LeftEyeConfidence;
-            eyeGazes->gaze[xr::Side::Right].gazeConfidence = m_cachedBodyState.RightEyeConfidence;
-
-            BodyTracking::Pose leftEyePose = m_cachedBodyState.LeftEyePose;
-            BodyTracking::Pose rightEyePose = m_cachedBodyState.RightEyePose;
+            BodyTracking::Pose leftEyePose = bodyState.LeftEyePose;
+            BodyTracking::Pose rightEyePose = bodyState.RightEyePose;
             XrPosef eyeGaze[] = {
                 xr::math::Pose::MakePose(
                     XrQuaternionf{leftEyePose.orientation.x,
@@ -144,7 +143,7 @@ namespace virtualdesktop_openxr {
 
             eyeGazes->gaze[xr::Side::Left].isValid = XR_FALSE;
             eyeGazes->gaze[xr::Side::Right].isValid = XR_FALSE;
-            if (m_cachedBodyState.LeftEyeIsValid || m_cachedBodyState.RightEyeIsValid) {
+            if (bodyState.LeftEyeIsValid || bodyState.RightEyeIsValid) {
                 // TODO: Need optimization here, in all likelyhood, the caller is looking for eye gaze relative to VIEW
                 // space, in which case we are doing 2 back-to-back getHmdPose() that are cancelling each other.
                 Space& xrBaseSpace = *(Space*)gazeInfo->baseSpace;
@@ -154,12 +153,12 @@ namespace virtualdesktop_openxr {
                     Pose::IsPoseValid(
                         locateSpaceToOrigin(xrBaseSpace, gazeInfo->time, baseSpaceToVirtual, nullptr, nullptr))) {
                     // Combine the poses.
-                    if (m_cachedBodyState.LeftEyeIsValid) {
+                    if (bodyState.LeftEyeIsValid) {
                         eyeGazes->gaze[xr::Side::Left].gazePose = Pose::Multiply(
                             Pose::Multiply(eyeGaze[xr::Side::Left], headPose), Pose::Invert(baseSpaceToVirtual));
                         eyeGazes->gaze[xr::Side::Left].isValid = XR_TRUE;
                     }
-                    if (m_cachedBodyState.RightEyeIsValid) {
+                    if (bodyState.RightEyeIsValid) {
                         eyeGazes->gaze[xr::Side::Right].gazePose = Pose::Multiply(
                             Pose::Multiply(eyeGaze[xr::Side::Right], headPose), Pose::Invert(baseSpaceToVirtual));
                         eyeGazes->gaze[xr::Side::Right].isValid = XR_TRUE;
@@ -172,8 +171,7 @@ namespace virtualdesktop_openxr {
             eyeGazes->gaze[xr::Side::Left].gazePose = eyeGazes->gaze[xr::Side::Right].gazePose = Pose::Identity();
         }
 
-        // We do not do any extrapolation.
-        eyeGazes->time = gazeInfo->time;
+        eyeGazes->time = getBodyStateSampleTime(gazeInfo->time, m_bodyStatePrediction.eyes);
 
         TraceLoggingWrite(g_traceProvider,
                           "xrGetEyeGazesFB",
@@ -190,24 +188,25 @@ namespace virtualdesktop_openxr {
 
     bool OpenXrRuntime::getEyeGaze(XrTime time, bool getStateOnly, XrVector3f& unitVector, XrTime& sampleTime) const {
         if (m_eyeTrackingType == EyeTracking::Mmf) {
-            std::shared_lock lock(m_bodyStateMutex);
+            BodyTracking::BodyStateV2 bodyState{};
+            getBodyState(time, bodyState);
 
             TraceLoggingWrite(g_traceProvider,
                               "VirtualDesktopEyeTracker",
-                              TLArg(!!m_cachedBodyState.LeftEyeIsValid, "LeftValid"),
-                              TLArg(m_cachedBodyState.LeftEyeConfidence, "LeftConfidence"),
-                              TLArg(!!m_cachedBodyState.RightEyeIsValid, "RightValid"),
-                              TLArg(m_cachedBodyState.RightEyeConfidence, "RightConfidence"));
+                              TLArg(!!bodyState.LeftEyeIsValid, "LeftValid"),
+                              TLArg(bodyState.LeftEyeConfidence, "LeftConfidence"),
+                              TLArg(!!bodyState.RightEyeIsValid, "RightValid"),
+                              TLArg(bodyState.RightEyeConfidence, "RightConfidence"));
 
-            if (!(m_cachedBodyState.LeftEyeIsValid && m_cachedBodyState.RightEyeIsValid)) {
+            if (!(bodyState.LeftEyeIsValid && bodyState.RightEyeIsValid)) {
                 return false;
             }
-            if (!(m_cachedBodyState.LeftEyeConfidence > 0.5f && m_cachedBodyState.RightEyeConfidence > 0.5f)) {
+            if (!(bodyState.LeftEyeConfidence > 0.5f && bodyState.RightEyeConfidence > 0.5f)) {
                 return false;
             }
 
-            BodyTracking::Pose leftEyePose = m_cachedBodyState.LeftEyePose;
-            BodyTracking::Pose rightEyePose = m_cachedBodyState.RightEyePose;
+            BodyTracking::Pose leftEyePose = bodyState.LeftEyePose;
+            BodyTracking::Pose rightEyePose = bodyState.RightEyePose;
             XrPosef eyeGaze[] = {
                 xr::math::Pose::MakePose(
                     XrQuaternionf{leftEyePose.orientation.x,
@@ -236,7 +235,7 @@ namespace virtualdesktop_openxr {
             unitVector = xr::math::Normalize(
                 {gazeProjectedPoint.m128_f32[0], gazeProjectedPoint.m128_f32[1], gazeProjectedPoint.m128_f32[2]});
 
-            sampleTime = time;
+            sampleTime = getBodyStateSampleTime(time, m_bodyStatePrediction.eyes);
 
         } else if (m_eyeTrackingType == EyeTracking::Simulated) {
             XrVector2f point{0.5f, 0.5f};
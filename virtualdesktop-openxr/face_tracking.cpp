@@ -131,18 +131,17 @@ namespace virtualdesktop_openxr {
         }
 
         // Forward the state from the memory mapped file.
-        if (m_bodyState) {
-            std::shared_lock lock(m_bodyStateMutex);
-
+        BodyTracking::BodyStateV2 bodyState{};
+        if (getBodyState(expressionInfo->time, bodyState)) {
             for (uint32_t i = 0; i < XR_FACE_EXPRESSION_COUNT_FB; i++) {
-                expressionWeights->weights[i] = m_cachedBodyState.ExpressionWeights[i];
+                expressionWeights->weights[i] = bodyState.ExpressionWeights[i];
             }
             for (uint32_t i = 0; i < XR_FACE_CONFIDENCE_COUNT_FB; i++) {
-                expressionWeights->confidences[i] = m_cachedBodyState.ExpressionConfidences[i];
+                expressionWeights->confidences[i] = bodyState.ExpressionConfidences[i];
             }
-            expressionWeights->status.isValid = m_cachedBodyState.FaceIsValid ? XR_TRUE : XR_FALSE;
+            expressionWeights->status.isValid = bodyState.FaceIsValid ? XR_TRUE : XR_FALSE;
             expressionWeights->status.isEyeFollowingBlendshapesValid =
-                m_cachedBodyState.IsEyeFollowingBlendshapesValid ? XR_TRUE : XR_FALSE;
+                bodyState.IsEyeFollowingBlendshapesValid ? XR_TRUE : XR_FALSE;
         } else {
             for (uint32_t i = 0; i < XR_FACE_EXPRESSION_COUNT_FB; i++) {
                 expressionWeights->weights[i] = 0.f;
@@ -153,8 +152,7 @@ namespace virtualdesktop_openxr {
             expressionWeights->status.isValid = expressionWeights->status.isEyeFollowingBlendshapesValid = XR_FALSE;
         }
 
-        // We do not do any extrapolation.
-        expressionWeights->time = expressionInfo->time;
+        expressionWeights->time = getBodyStateSampleTime(expressionInfo->time, m_bodyStatePrediction.face);
 
         TraceLoggingWrite(
             g_traceProvider,
@@ -276,18 +274,17 @@ namespace virtualdesktop_openxr {
         const FaceTracker& xrFaceTracker = *(FaceTracker*)faceTracker;
 
         // Forward the state from the memory mapped file.
-        if (m_bodyState) {
-            std::shared_lock lock(m_bodyStateMutex);
-
+        BodyTracking::BodyStateV2 bodyState{};
+        if (getBodyState(expressionInfo->time, bodyState)) {
             for (uint32_t i = 0; i < XR_FACE_EXPRESSION2_COUNT_FB; i++) {
-                expressionWeights->weights[i] = m_cachedBodyState.ExpressionWeights[i];
+                expressionWeights->weights[i] = bodyState.ExpressionWeights[i];
             }
             for (uint32_t i = 0; i < XR_FACE_CONFIDENCE2_COUNT_FB; i++) {
-                expressionWeights->confidences[i] = m_cachedBodyState.ExpressionConfidences[i];
+                expressionWeights->confidences[i] = bodyState.ExpressionConfidences[i];
             }
-            expressionWeights->isValid = m_cachedBodyState.FaceIsValid ? XR_TRUE : XR_FALSE;
+            expressionWeights->isValid = bodyState.FaceIsValid ? XR_TRUE : XR_FALSE;
             expressionWeights->isEyeFollowingBlendshapesValid =
-                m_cachedBodyState.IsEyeFollowingBlendshapesValid ? XR_TRUE : XR_FALSE;
+                bodyState.IsEyeFollowingBlendshapesValid ? XR_TRUE : XR_FALSE;
         } else {
             for (uint32_t i = 0; i < XR_FACE_EXPRESSION2_COUNT_FB; i++) {
                 expressionWeights->weights[i] = 0.f;
@@ -300,8 +297,7 @@ namespace virtualdesktop_openxr {
         expressionWeights->dataSource = xrFaceTracker.canUseVisualSource ? XR_FACE_TRACKING_DATA_SOURCE2_VISUAL_FB
                                                                          : XR_FACE_TRACKING_DATA_SOURCE2_AUDIO_FB;
 
-        // We do not do any extrapolation.
-        expressionWeights->time = expressionInfo->time;
+        expressionWeights->time = getBodyStateSampleTime(expressionInfo->time, m_bodyStatePrediction.face);
 
         TraceLoggingWrite(
             g_traceProvider,
@@ -37,6 +37,8 @@ namespace virtualdesktop_openxr {
     XrResult OpenXrRuntime::xrWaitFrame(XrSession session,
                                         const XrFrameWaitInfo* frameWaitInfo,
                                         XrFrameState* frameState) {
+        auto timeline = m_timeline.scope(TimelineEvent::WaitFrame);
+
         if ((frameWaitInfo && frameWaitInfo->type != XR_TYPE_FRAME_WAIT_INFO) ||
             frameState->type != XR_TYPE_FRAME_STATE) {
             return XR_ERROR_VALIDATION_FAILURE;
@@ -91,7 +93,7 @@ namespace virtualdesktop_openxr {
         // Critical section.
         {
             CpuTimer waitTimer;
-            if (IsTraceEnabled()) {
+            if (IsTraceEnabled() || m_frameMetrics) {
                 waitTimer.start();
             }
 
@@ -137,7 +139,7 @@ namespace virtualdesktop_openxr {
             }
 
             if (m_needStartAsyncSubmissionThread) {
-                m_terminateAsyncThread = false;
+                m_layersForAsyncSubmission.reset();
                 m_asyncSubmissionThread = std::thread([&]() { asyncSubmissionThread(); });
                 m_needStartAsyncSubmissionThread = false;
             }
@@ -148,7 +150,7 @@ namespace virtualdesktop_openxr {
                 TraceLocalActivity(waitToBeginFrame);
                 TraceLoggingWriteStart(waitToBeginFrame, "OVR_WaitToBeginFrame", TLArg(ovrFrameId, "FrameId"));
                 lock.unlock();
-                CHECK_OVRCMD(ovr_WaitToBeginFrame(m_ovrSession, ovrFrameId));
+                CHECK_OVRCMD(m_frameCompositor->waitToBeginFrame(ovrFrameId));
                 lock.lock();
                 TraceLoggingWriteStop(waitToBeginFrame, "OVR_WaitToBeginFrame");
             } else {
@@ -156,12 +158,13 @@ namespace virtualdesktop_openxr {
                 TraceLoggingWrite(g_traceProvider, "AcquiredFrame", TLArg(ovrFrameId, "FrameId"));
             }
 
-            if (IsTraceEnabled()) {
+            if (IsTraceEnabled() || m_frameMetrics) {
                 waitTimer.stop();
+                m_lastWaitFrameTimeUs = waitTimer.query(false);
             }
 
             const double now = ovr_GetTimeInSeconds();
-            double predictedDisplayTime = ovr_GetPredictedDisplayTime(m_ovrSession, ovrFrameId);
+            double predictedDisplayTime = m_frameCompositor->getPredictedDisplayTime(ovrFrameId);
             TraceLoggingWrite(g_traceProvider,
                               "WaitFrame",
                               TLArg(now, "Now"),
@@ -177,12 +180,18 @@ namespace virtualdesktop_openxr {
                 frameState->predictedDisplayTime = m_lastPredictedDisplayTime + 1;
             }
             m_lastPredictedDisplayTime = frameState->predictedDisplayTime;
+            if (m_frameLoopValidator) {
+                m_frameLoopValidator->checkPredictedDisplayTime(ovrFrameId, frameState->predictedDisplayTime);
+            }
 
             // We always use the native frame duration, regardless of Smart Smoothing.
             frameState->predictedDisplayPeriod = (XrDuration)(m_predictedFrameDuration * 1e9);
 
             m_frameTimerApp.start();
 
+            // Tracking must be queried again for the new frame, even if the app keeps requesting the same time.
+            invalidateTrackingSnapshots();
+
             m_frameWaited++;
 
             TraceLoggingWrite(g_traceProvider,
@@ -198,11 +207,16 @@ namespace virtualdesktop_openxr {
                           TLArg(frameState->predictedDisplayTime, "PredictedDisplayTime"),
                           TLArg(frameState->predictedDisplayPeriod, "PredictedDisplayPeriod"));
 
+        timeline.setArgs(frameState->predictedDisplayTime, (uint32_t)m_frameWaited);
+        timeline.setSucceeded();
+
         return XR_SUCCESS;
     }
 
     // https://www.khronos.org/registry/OpenXR/specs/1.0/html/xrspec.html#xrBeginFrame
     XrResult OpenXrRuntime::xrBeginFrame(XrSession session, const XrFrameBeginInfo* frameBeginInfo) {
+        auto timeline = m_timeline.scope(TimelineEvent::BeginFrame);
+
         if (frameBeginInfo && frameBeginInfo->type != XR_TYPE_FRAME_BEGIN_INFO) {
             return XR_ERROR_VALIDATION_FAILURE;
         }
@@ -251,9 +265,12 @@ namespace virtualdesktop_openxr {
             // Tell OVR we are about to begin the frame.
             const long long ovrFrameId = m_frameWaited - 1;
             if (!m_useAsyncSubmission) {
+                if (m_frameBegun != m_frameCompleted) {
+                    m_frameCompositor->discardFrame(m_frameBegun - 1);
+                }
                 TraceLocalActivity(beginFrame);
                 TraceLoggingWriteStart(beginFrame, "OVR_BeginFrame", TLArg(ovrFrameId, "FrameId"));
-                CHECK_OVRCMD(ovr_BeginFrame(m_ovrSession, ovrFrameId));
+                CHECK_OVRCMD(m_frameCompositor->beginFrame(ovrFrameId));
                 TraceLoggingWriteStop(beginFrame, "OVR_BeginFrame");
             }
 
@@ -306,9 +323,14 @@ namespace virtualdesktop_openxr {
             m_frameCondVar.notify_all();
 
             bool isAsyncReprojectionActive = false;
+            double compositorTime = 0.0;
             ovrPerfStats stats{};
-            if (OVR_SUCCESS(ovr_GetPerfStats(m_ovrSession, &stats))) {
+            if (OVR_SUCCESS(m_frameCompositor->getPerfStats(stats))) {
                 isAsyncReprojectionActive = stats.FrameStatsCount > 0 && stats.FrameStats[0].AswIsActive;
+                if (stats.FrameStatsCount > 0) {
+                    compositorTime = std::max(stats.FrameStats[0].CompositorCpuStartToGpuEndElapsedTime, 0.f);
+                    m_lastDroppedFrameCount = stats.FrameStats[0].AppDroppedFrameCount;
+                }
                 TraceLoggingWrite(
                     g_traceProvider, "OVR_AswStatus", TLArg(isAsyncReprojectionActive, "AsyncReprojectionActive"));
             }
@@ -318,13 +340,33 @@ namespace virtualdesktop_openxr {
             } else {
                 m_predictedFrameDuration = m_idealFrameDuration;
             }
+            m_lastCompositorTimeUs = compositorTime * 1e6;
+            m_isAsyncReprojectionActive = isAsyncReprojectionActive;
+
+            // Adjust the running start for the next frame.
+            m_runningStart.setPolicy(m_runningStartPolicy);
+            m_runningStart.update(
+                m_lastCpuFrameTimeUs / 1e6, m_lastGpuFrameTimeUs / 1e6, compositorTime, m_predictedFrameDuration);
+            TraceLoggingWrite(g_traceProvider,
+                              "RunningStart",
+                              TLArg((int)m_runningStart.getPolicy(), "Policy"),
+                              TLArg(m_runningStart.getAppCpuEstimate(), "AppCpuEstimate"),
+                              TLArg(m_runningStart.getAppGpuEstimate(), "AppGpuEstimate"),
+                              TLArg(m_runningStart.getCompositorEstimate(), "CompositorEstimate"),
+                              TLArg(m_predictedFrameDuration, "FrameDuration"),
+                              TLArg(m_runningStart.getOffset(), "Offset"));
         }
 
+        timeline.setArgs(m_frameBegun, frameDiscarded ? 1 : 0);
+        timeline.setSucceeded();
+
         return !frameDiscarded ? XR_SUCCESS : XR_FRAME_DISCARDED;
     }
 
     // https://www.khronos.org/registry/OpenXR/specs/1.0/html/xrspec.html#xrEndFrame
     XrResult OpenXrRuntime::xrEndFrame(XrSession session, const XrFrameEndInfo* frameEndInfo) {
+        auto timeline = m_timeline.scope(TimelineEvent::EndFrame);
+
         if (frameEndInfo->type != XR_TYPE_FRAME_END_INFO) {
             return XR_ERROR_VALIDATION_FAILURE;
         }
@@ -368,6 +410,11 @@ namespace virtualdesktop_openxr {
                 return XR_ERROR_CALL_ORDER_INVALID;
             }
 
+            CpuTimer endFrameTimer;
+            if (m_frameMetrics) {
+                endFrameTimer.start();
+            }
+
             m_renderTimerApp.stop();
             if (m_gpuTimerApp[m_currentTimerIndex]) {
                 m_gpuTimerApp[m_currentTimerIndex]->stop();
@@ -381,6 +428,11 @@ namespace virtualdesktop_openxr {
                 // context.
             }
 
+            // Free the swapchains destroyed by the application that the GPU is done with, and the pooled swapchains
+            // that were not recycled in time.
+            releaseSwapchains(m_swapchainPool.evictExpired(ovr_GetTimeInSeconds()));
+            releaseCompletedSwapchains();
+
             // Serializes the app work between D3D12/Vulkan and D3D11.
             if (isD3D12Session()) {
                 serializeD3D12Frame();
@@ -409,11 +461,15 @@ namespace virtualdesktop_openxr {
 
             m_precompositor.displayTime = frameEndInfo->displayTime;
             m_precompositor.isFirstProjectionLayer = true;
-            m_precompositor.processedSwapchainImages.clear();
+
+            // All the per-frame allocations below come from the arena. A projection layer may use up to 4 swapchain
+            // images (color and depth for each view).
+            m_frameArena.reset();
+            m_precompositor.processedSwapchainImages =
+                ArenaVector<std::pair<Swapchain*, uint32_t>>(m_frameArena, frameEndInfo->layerCount * 4);
 
             // Construct the list of layers.
-            std::vector<ovrLayer_Union> layersAllocator;
-            layersAllocator.reserve(frameEndInfo->layerCount + 1);
+            ArenaVector<ovrLayer_Union> layersAllocator(m_frameArena, frameEndInfo->layerCount + 1);
             for (uint32_t i = 0; i < frameEndInfo->layerCount; i++) {
                 if (!frameEndInfo->layers[i]) {
                     return XR_ERROR_LAYER_INVALID;
@@ -475,12 +531,27 @@ namespace virtualdesktop_openxr {
                 }
             }
 
+            // Issue all the swapchain commits for the frame at once.
+            commitSwapchainImages(m_precompositor.processedSwapchainImages);
+
             // Add a dummy layer so we can still call ovr_endFrame() for timing purposes.
             if (layersAllocator.empty()) {
                 layersAllocator.push_back({});
                 layersAllocator.back().Header.Type = ovrLayerType_Disabled;
             }
 
+            TraceLoggingWrite(g_traceProvider,
+                              "FrameArena",
+                              TLArg(m_frameArena.getUsed(), "Used"),
+                              TLArg(m_frameArena.getHighWaterMark(), "HighWaterMark"),
+                              TLArg(m_frameArena.getCapacity(), "Capacity"));
+            TraceLoggingWrite(g_traceProvider,
+                              "ViewCache",
+                              TLArg(m_viewCache.size(), "Size"),
+                              TLArg(m_viewCache.getHits(), "Hits"),
+                              TLArg(m_viewCache.getMisses(), "Misses"),
+                              TLArg(m_viewCache.getEvictions(), "Evictions"));
+
             if (IsTraceEnabled() && m_gpuTimerPrecomposition) {
                 m_gpuTimerPrecomposition[m_currentTimerIndex]->stop();
             }
@@ -501,7 +572,7 @@ namespace virtualdesktop_openxr {
             // Submit the layers to OVR.
             const long long ovrFrameId = m_frameBegun - 1;
             if (!m_useAsyncSubmission) {
-                std::vector<ovrLayerHeader*> layers;
+                ArenaVector<ovrLayerHeader*> layers(m_frameArena, layersAllocator.size());
                 for (auto& layer : layersAllocator) {
                     layers.push_back(&layer.Header);
 
@@ -523,7 +594,7 @@ namespace virtualdesktop_openxr {
                 scaleDesc.HmdToEyePose[xr::StereoView::Right] = m_cachedEyeInfo[xr::StereoView::Right].HmdToEyePose;
                 scaleDesc.HmdSpaceToWorldScaleInMeters = 1.f;
                 CHECK_OVRCMD(
-                    ovr_EndFrame(m_ovrSession, ovrFrameId, &scaleDesc, layers.data(), (unsigned int)layers.size()));
+                    m_frameCompositor->endFrame(ovrFrameId, &scaleDesc, layers.data(), (unsigned int)layers.size()));
                 TraceLoggingWriteStop(endFrame, "OVR_EndFrame");
             }
 
@@ -551,15 +622,46 @@ namespace virtualdesktop_openxr {
                                   TLArg(m_frameTimes.size(), "Fps"),
                                   TLArg(lastPrecompositionTime, "LastPrecompositionTimeUs"));
 
-                std::unique_lock lock(m_asyncSubmissionMutex);
-                m_layersForAsyncSubmission = layersAllocator;
-
-                m_asyncSubmissionCondVar.notify_all();
+                auto& slot = m_layersForAsyncSubmission.back();
+                slot.count = (uint32_t)std::min(layersAllocator.size(), (size_t)ovrMaxLayerCount);
+                if (slot.count < layersAllocator.size()) {
+                    ErrorLog("Too many layers in this frame (%u)\n", layersAllocator.size());
+                }
+                std::copy_n(layersAllocator.begin(), slot.count, slot.items);
+                m_layersForAsyncSubmission.publish();
 
                 // From this point, we know that the asynchronous thread may be executing, and we shall not use the
                 // submission context.
             }
 
+            if (m_frameMetrics) {
+                endFrameTimer.stop();
+
+                FrameMetrics metrics{};
+                metrics.frameId = ovrFrameId;
+                metrics.waitTime = (float)m_lastWaitFrameTimeUs;
+                metrics.appCpuTime = (float)m_lastCpuFrameTimeUs;
+                metrics.appGpuTime = (float)m_lastGpuFrameTimeUs;
+                metrics.compositorTime = (float)m_lastCompositorTimeUs;
+                metrics.endFrameTime = (float)endFrameTimer.query();
+                metrics.droppedFrames = m_lastDroppedFrameCount;
+                metrics.layerCount = (uint8_t)std::min(layersAllocator.size(), (size_t)UINT8_MAX);
+                metrics.isAsyncReprojectionActive = m_isAsyncReprojectionActive;
+                m_frameMetrics->record(metrics);
+
+                // The file I/O happens on a worker thread, with a copy of the metrics. A request made while a previous
+                // export is still running is picked up by a later frame.
+                const bool isExportPending = m_frameMetricsExport.valid() &&
+                                             m_frameMetricsExport.wait_for(0s) != std::future_status::ready;
+                if (!isExportPending && m_frameMetricsExportRequested.exchange(false)) {
+                    m_frameMetricsExport =
+                        std::async(std::launch::async,
+                                   [this, snapshot = std::make_shared<FrameMetricsRecorder>(*m_frameMetrics)]() {
+                                       exportFrameMetrics(*snapshot);
+                                   });
+                }
+            }
+
             m_frameCompleted = m_frameBegun;
             updateSessionState();
 
@@ -576,6 +678,9 @@ namespace virtualdesktop_openxr {
             m_frameCondVar.notify_all();
         }
 
+        timeline.setArgs(frameEndInfo->displayTime, frameEndInfo->layerCount);
+        timeline.setSucceeded();
+
         return XR_SUCCESS;
     }
 
@@ -637,10 +742,20 @@ namespace virtualdesktop_openxr {
                 m_precompositor.isProj0SRGB = isSRGBFormat(xrSwapchain.dxgiFormatForSubmission);
             }
 
-            // Fill out color buffer information.
+            // Fill out color buffer information. A slice is only pre-processed once per frame, so it must cover the
+            // rects of all the views sharing it (eg: both eyes side-by-side in the same image).
+            XrRect2Di preprocessRect = proj.views[viewIndex].subImage.imageRect;
+            for (uint32_t otherViewIndex = 0; otherViewIndex < xr::StereoView::Count; otherViewIndex++) {
+                const XrSwapchainSubImage& otherSubImage = proj.views[otherViewIndex].subImage;
+                if (otherSubImage.swapchain == proj.views[viewIndex].subImage.swapchain &&
+                    otherSubImage.imageArrayIndex == proj.views[viewIndex].subImage.imageArrayIndex) {
+                    preprocessRect = UnionImageRect(preprocessRect, otherSubImage.imageRect);
+                }
+            }
             preprocessSwapchainImage(xrSwapchain,
                                      m_precompositor.layerIndex,
                                      proj.views[viewIndex].subImage.imageArrayIndex,
+                                     &preprocessRect,
                                      proj.layerFlags,
                                      m_precompositor.processedSwapchainImages);
             layer.EyeFov.ColorTexture[viewIndex] =
@@ -714,6 +829,7 @@ namespace virtualdesktop_openxr {
                                 xrDepthSwapchain,
                                 m_precompositor.layerIndex,
                                 depth->subImage.imageArrayIndex,
+                                &depth->subImage.imageRect,
                                 XR_COMPOSITION_LAYER_BLEND_TEXTURE_SOURCE_ALPHA_BIT, /* No-op for depth */
                                 m_precompositor.processedSwapchainImages);
                             layer.EyeFovDepth.DepthTexture[viewIndex] =
@@ -819,6 +935,7 @@ namespace virtualdesktop_openxr {
         preprocessSwapchainImage(xrSwapchain,
                                  m_precompositor.layerIndex,
                                  quad.subImage.imageArrayIndex,
+                                 &quad.subImage.imageRect,
                                  quad.layerFlags,
                                  m_precompositor.processedSwapchainImages);
         layer.Quad.ColorTexture = xrSwapchain.resolvedSlices[quad.subImage.imageArrayIndex].ovrSwapchain;
@@ -895,8 +1012,12 @@ namespace virtualdesktop_openxr {
         }
 
         // Fill out color buffer information.
-        preprocessSwapchainImage(
-            xrSwapchain, m_precompositor.layerIndex, 0, cube.layerFlags, m_precompositor.processedSwapchainImages);
+        preprocessSwapchainImage(xrSwapchain,
+                                 m_precompositor.layerIndex,
+                                 0,
+                                 nullptr /* Entire cube faces */,
+                                 cube.layerFlags,
+                                 m_precompositor.processedSwapchainImages);
         layer.Cube.CubeMapTexture = xrSwapchain.resolvedSlices[0].ovrSwapchain;
 
         if (!m_spaces.count(cube.space)) {
@@ -935,7 +1056,7 @@ namespace virtualdesktop_openxr {
             {
                 TraceLocalActivity(waitToBeginFrame);
                 TraceLoggingWriteStart(waitToBeginFrame, "OVR_WaitToBeginFrame", TLArg(ovrFrameId, "FrameId"));
-                const auto result = ovr_WaitToBeginFrame(m_ovrSession, ovrFrameId);
+                const auto result = m_frameCompositor->waitToBeginFrame(ovrFrameId);
                 TraceLoggingWriteStop(waitToBeginFrame, "OVR_WaitToBeginFrame", TLArg((int)result, "Result"));
                 if (result == ovrError_Timeout) {
                     ErrorLog("Timeout in async submission thread! This is normal if you have a debugger attached.\n");
@@ -952,45 +1073,32 @@ namespace virtualdesktop_openxr {
             {
                 TraceLocalActivity(beginFrame);
                 TraceLoggingWriteStart(beginFrame, "OVR_BeginFrame", TLArg(ovrFrameId, "FrameId"));
-                CHECK_OVRCMD(ovr_BeginFrame(m_ovrSession, ovrFrameId));
+                CHECK_OVRCMD(m_frameCompositor->beginFrame(ovrFrameId));
                 TraceLoggingWriteStop(beginFrame, "OVR_BeginFrame");
             }
 
-            {
-                std::unique_lock lock(m_asyncSubmissionMutex);
-
-                // Mark us as ready to accept a new frame.
-                m_layersForAsyncSubmission.clear();
-                m_asyncSubmissionCondVar.notify_all();
-
-                // Wait for the frame.
-                m_asyncSubmissionCondVar.wait(
-                    lock, [&] { return m_terminateAsyncThread || !m_layersForAsyncSubmission.empty(); });
-            }
-            if (m_terminateAsyncThread) {
+            // Mark us as ready to accept a new frame, then wait for the frame.
+            m_layersForAsyncSubmission.markIdle();
+            auto* slot = m_layersForAsyncSubmission.acquire();
+            if (!slot) {
                 break;
             }
 
             {
-                std::vector<ovrLayerHeader*> layers;
-                for (auto& layer : m_layersForAsyncSubmission) {
-                    layers.push_back(&layer.Header);
-
-                    if (layers.size() == ovrMaxLayerCount) {
-                        ErrorLog("Too many layers in this frame (%u)\n", m_layersForAsyncSubmission.size());
-                        break;
-                    }
+                // The slot is ours until the next call to acquire().
+                ovrLayerHeader* layers[ovrMaxLayerCount];
+                for (uint32_t i = 0; i < slot->count; i++) {
+                    layers[i] = &slot->items[i].Header;
                 }
 
                 TraceLocalActivity(endFrame);
                 TraceLoggingWriteStart(
-                    endFrame, "OVR_EndFrame", TLArg(ovrFrameId, "FrameId"), TLArg(layers.size(), "NumLayers"));
+                    endFrame, "OVR_EndFrame", TLArg(ovrFrameId, "FrameId"), TLArg(slot->count, "NumLayers"));
                 ovrViewScaleDesc scaleDesc{};
                 scaleDesc.HmdToEyePose[xr::StereoView::Left] = m_cachedEyeInfo[xr::StereoView::Left].HmdToEyePose;
                 scaleDesc.HmdToEyePose[xr::StereoView::Right] = m_cachedEyeInfo[xr::StereoView::Right].HmdToEyePose;
                 scaleDesc.HmdSpaceToWorldScaleInMeters = 1.f;
-                CHECK_OVRCMD(
-                    ovr_EndFrame(m_ovrSession, ovrFrameId, &scaleDesc, layers.data(), (unsigned int)layers.size()));
+                CHECK_OVRCMD(m_frameCompositor->endFrame(ovrFrameId, &scaleDesc, layers, slot->count));
                 TraceLoggingWriteStop(endFrame, "OVR_EndFrame");
             }
         }
@@ -998,26 +1106,40 @@ namespace virtualdesktop_openxr {
         TraceLoggingWriteStop(local, "AsyncSubmissionThread");
     }
 
+    // Write out the frame metrics next to the log file.
+    void OpenXrRuntime::exportFrameMetrics(const FrameMetricsRecorder& frameMetrics) const {
+        const auto csvPath = programData / "OpenXR-FrameMetrics.csv";
+        const auto jsonPath = programData / "OpenXR-FrameMetrics.json";
+
+        std::ofstream csv(csvPath, std::ios_base::trunc);
+        frameMetrics.writeCsv(csv);
+        std::ofstream json(jsonPath, std::ios_base::trunc);
+        frameMetrics.writeJson(json);
+
+        TraceLoggingWrite(g_traceProvider, "ExportFrameMetrics", TLArg(csvPath.c_str(), "Path"));
+        Log("Frame metrics written to %ls and %ls\n", csvPath.c_str(), jsonPath.c_str());
+    }
+
     void OpenXrRuntime::waitForAsyncSubmissionIdle(bool doRunningStart) {
         TraceLocalActivity(waitToBeginFrame);
         TraceLoggingWriteStart(waitToBeginFrame, "WaitForAsyncSubmissionIdle", TLArg(doRunningStart, "DoRunningStart"));
 
-        std::unique_lock lock(m_asyncSubmissionMutex);
-
         bool wokeUpEarly = false;
+        double runningStart = 0.0;
         if (doRunningStart) {
-            constexpr double RunningStart = 0.002;
+            runningStart = m_runningStart.getOffset();
             const auto timeout =
-                m_lastWaitToBeginFrameTime + std::chrono::duration<double>(m_predictedFrameDuration - RunningStart);
+                m_lastWaitToBeginFrameTime + std::chrono::duration<double>(m_predictedFrameDuration - runningStart);
 
-            wokeUpEarly =
-                !m_asyncSubmissionCondVar.wait_until(lock, timeout, [&] { return m_layersForAsyncSubmission.empty(); });
+            wokeUpEarly = !m_layersForAsyncSubmission.waitForIdle(std::make_optional(timeout));
         } else {
-            m_asyncSubmissionCondVar.wait(lock, [&] { return m_layersForAsyncSubmission.empty(); });
+            m_layersForAsyncSubmission.waitForIdle();
         }
 
-        TraceLoggingWriteStop(
-            waitToBeginFrame, "WaitForAsyncSubmissionIdle", TLArg(wokeUpEarly, "WokeUpForRunningStart"));
+        TraceLoggingWriteStop(waitToBeginFrame,
+                              "WaitForAsyncSubmissionIdle",
+                              TLArg(wokeUpEarly, "WokeUpForRunningStart"),
+                              TLArg(runningStart, "RunningStart"));
     }
 
 } // namespace virtualdesktop_openxr
@@ -0,0 +1,189 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "pch.h"
+
+namespace virtualdesktop_openxr::utils {
+
+    // A bump allocator for the data that only lives for the duration of a frame. All allocations are released at
+    // once by reset(). Once the arena has grown to the size needed by the application, no more heap allocations occur.
+    class FrameArena {
+      public:
+        static constexpr uint8_t k_poisonValue = 0xcd;
+
+        FrameArena(size_t initialSize = 16 * 1024) {
+            m_blocks.push_back({std::make_unique<uint8_t[]>(initialSize), initialSize});
+        }
+
+        // Poisoning fills all released memory, so that any use past reset() is easy to spot.
+        void setPoisoning(bool poison) {
+            m_poison = poison;
+        }
+
+        void* allocate(size_t size, size_t alignment) {
+            while (true) {
+                Block& block = m_blocks.back();
+                const uintptr_t base = (uintptr_t)block.storage.get();
+                const uintptr_t start = (base + m_offset + alignment - 1) & ~(uintptr_t)(alignment - 1);
+                if (start + size <= base + block.size) {
+                    m_used += (start + size) - (base + m_offset);
+                    m_offset = start + size - base;
+                    m_highWaterMark = std::max(m_highWaterMark, m_used);
+                    return (void*)start;
+                }
+
+                // Chain a new block. It will be consolidated upon reset().
+                const size_t newSize = std::max(block.size * 2, size + alignment);
+                m_blocks.push_back({std::make_unique<uint8_t[]>(newSize), newSize});
+                m_offset = 0;
+            }
+        }
+
+        template <typename T>
+        T* allocate(size_t count) {
+            static_assert(std::is_trivially_destructible_v<T>, "Arena objects are never destroyed");
+            T* objects = (T*)allocate(count * sizeof(T), alignof(T));
+            for (size_t i = 0; i < count; i++) {
+                new (&objects[i]) T{};
+            }
+            return objects;
+        }
+
+        // Release all the allocations. Must not be called while any allocation is still in use.
+        void reset() {
+            if (m_blocks.size() > 1) {
+                // Replace the chain with a single block large enough for the whole frame.
+                size_t totalSize = 0;
+                for (const auto& block : m_blocks) {
+                    totalSize += block.size;
+                }
+                m_blocks.clear();
+                m_blocks.push_back({std::make_unique<uint8_t[]>(totalSize), totalSize});
+                m_offset = totalSize;
+            }
+
+            if (m_poison) {
+                memset(m_blocks.back().storage.get(), k_poisonValue, m_offset);
+            }
+
+            m_offset = 0;
+            m_used = 0;
+        }
+
+        // Bytes used since the last reset().
+        size_t getUsed() const {
+            return m_used;
+        }
+
+        // Most bytes ever used between two reset().
+        size_t getHighWaterMark() const {
+            return m_highWaterMark;
+        }
+
+        size_t getCapacity() const {
+            return m_blocks.back().size;
+        }
+
+      private:
+        struct Block {
+            std::unique_ptr<uint8_t[]> storage;
+            size_t size;
+        };
+
+        std::vector<Block> m_blocks;
+        size_t m_offset{0};
+        size_t m_used{0};
+        size_t m_highWaterMark{0};
+        bool m_poison{false};
+    };
+
+    // A vector-like container backed by a FrameArena. Only valid until the arena is reset.
+    template <typename T>
+    class ArenaVector {
+      public:
+        ArenaVector() = default;
+        ArenaVector(FrameArena& arena, size_t capacity)
+            : m_arena(&arena), m_items(arena.allocate<T>(capacity)), m_capacity(capacity) {
+        }
+
+        void push_back(const T& item) {
+            if (m_size == m_capacity) {
+                // Leave the old storage behind, it will be reclaimed upon reset().
+                const size_t newCapacity = std::max(m_capacity * 2, (size_t)4);
+                T* newItems = m_arena->allocate<T>(newCapacity);
+                std::copy_n(m_items, m_size, newItems);
+                m_items = newItems;
+                m_capacity = newCapacity;
+            }
+            m_items[m_size++] = item;
+        }
+
+        bool contains(const T& item) const {
+            return std::find(begin(), end(), item) != end();
+        }
+
+        void clear() {
+            m_size = 0;
+        }
+
+        bool empty() const {
+            return m_size == 0;
+        }
+
+        size_t size() const {
+            return m_size;
+        }
+
+        T* data() {
+            return m_items;
+        }
+
+        T& back() {
+            return m_items[m_size - 1];
+        }
+
+        T* begin() {
+            return m_items;
+        }
+
+        T* end() {
+            return m_items + m_size;
+        }
+
+        const T* begin() const {
+            return m_items;
+        }
+
+        const T* end() const {
+            return m_items + m_size;
+        }
+
+      private:
+        FrameArena* m_arena{nullptr};
+        T* m_items{nullptr};
+        size_t m_capacity{0};
+        size_t m_size{0};
+    };
+
+} // namespace virtualdesktop_openxr::utils
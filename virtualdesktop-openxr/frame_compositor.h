@@ -0,0 +1,300 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "pch.h"
+
+#include "log.h"
+
+namespace virtualdesktop_openxr {
+
+    // The compositor side of the frame loop. xrWaitFrame(), xrBeginFrame(), xrEndFrame() and the async submission
+    // thread only talk to the compositor through this interface.
+    struct IFrameCompositor {
+        virtual ~IFrameCompositor() = default;
+
+        virtual ovrResult waitToBeginFrame(long long frameId) = 0;
+        virtual ovrResult beginFrame(long long frameId) = 0;
+        // The application forfeited a begun frame, which will never be ended.
+        virtual void discardFrame(long long frameId) = 0;
+        virtual ovrResult endFrame(long long frameId,
+                                   const ovrViewScaleDesc* viewScaleDesc,
+                                   ovrLayerHeader const* const* layers,
+                                   unsigned int layerCount) = 0;
+        virtual double getPredictedDisplayTime(long long frameId) = 0;
+        virtual ovrResult getPerfStats(ovrPerfStats& stats) = 0;
+    };
+
+    // The LibOVR compositor.
+    class OvrFrameCompositor : public IFrameCompositor {
+      public:
+        OvrFrameCompositor(ovrSession session) : m_session(session) {
+        }
+
+        ovrResult waitToBeginFrame(long long frameId) override {
+            return ovr_WaitToBeginFrame(m_session, frameId);
+        }
+
+        ovrResult beginFrame(long long frameId) override {
+            return ovr_BeginFrame(m_session, frameId);
+        }
+
+        void discardFrame(long long frameId) override {
+            // LibOVR lets the next ovr_BeginFrame() supersede the frame.
+        }
+
+        ovrResult endFrame(long long frameId,
+                           const ovrViewScaleDesc* viewScaleDesc,
+                           ovrLayerHeader const* const* layers,
+                           unsigned int layerCount) override {
+            return ovr_EndFrame(m_session, frameId, viewScaleDesc, layers, layerCount);
+        }
+
+        double getPredictedDisplayTime(long long frameId) override {
+            return ovr_GetPredictedDisplayTime(m_session, frameId);
+        }
+
+        ovrResult getPerfStats(ovrPerfStats& stats) override {
+            return ovr_GetPerfStats(m_session, &stats);
+        }
+
+      private:
+        const ovrSession m_session;
+    };
+
+    // Check the sequence of calls made to a compositor, and report any violation of the frame loop invariants: frames
+    // are waited in order (a frame may be waited again after a failed wait), each frame is begun at most once and only
+    // after being waited, every begun frame is either ended or explicitly discarded, and the predicted display times
+    // handed to the application increase.
+    class FrameLoopValidator : public IFrameCompositor {
+      public:
+        FrameLoopValidator(std::unique_ptr<IFrameCompositor> compositor) : m_compositor(std::move(compositor)) {
+        }
+
+        ovrResult waitToBeginFrame(long long frameId) override {
+            {
+                std::unique_lock lock(m_mutex);
+                if (m_lastWaited && frameId < m_lastWaited.value()) {
+                    report("Frame %lld waited after frame %lld\n", frameId, m_lastWaited.value());
+                }
+                m_lastWaited = frameId;
+            }
+
+            return m_compositor->waitToBeginFrame(frameId);
+        }
+
+        ovrResult beginFrame(long long frameId) override {
+            {
+                std::unique_lock lock(m_mutex);
+                if (!m_lastWaited || frameId > m_lastWaited.value()) {
+                    report("Frame %lld begun before being waited\n", frameId);
+                }
+                if (m_lastBegun && frameId <= m_lastBegun.value()) {
+                    report("Frame %lld begun after frame %lld\n", frameId, m_lastBegun.value());
+                }
+                if (m_lastBegun && m_lastEnded != m_lastBegun && m_lastDiscarded != m_lastBegun) {
+                    report("Frame %lld was begun but never ended\n", m_lastBegun.value());
+                }
+                m_lastBegun = frameId;
+            }
+
+            return m_compositor->beginFrame(frameId);
+        }
+
+        void discardFrame(long long frameId) override {
+            {
+                std::unique_lock lock(m_mutex);
+                if (m_lastBegun != frameId) {
+                    report("Frame %lld discarded but frame %lld is the one begun\n", frameId, m_lastBegun.value_or(-1));
+                }
+                m_lastDiscarded = frameId;
+            }
+
+            m_compositor->discardFrame(frameId);
+        }
+
+        ovrResult endFrame(long long frameId,
+                           const ovrViewScaleDesc* viewScaleDesc,
+                           ovrLayerHeader const* const* layers,
+                           unsigned int layerCount) override {
+            {
+                std::unique_lock lock(m_mutex);
+                if (m_lastBegun != frameId) {
+                    report("Frame %lld ended but frame %lld is the one begun\n", frameId, m_lastBegun.value_or(-1));
+                }
+                if (m_lastEnded && frameId <= m_lastEnded.value()) {
+                    report("Frame %lld ended after frame %lld\n", frameId, m_lastEnded.value());
+                }
+                m_lastEnded = frameId;
+            }
+
+            return m_compositor->endFrame(frameId, viewScaleDesc, layers, layerCount);
+        }
+
+        // The compositor may predict a time that regressed (eg: during early calls), and xrWaitFrame() corrects it
+        // before returning to the application. The corrected time is checked with checkPredictedDisplayTime().
+        double getPredictedDisplayTime(long long frameId) override {
+            return m_compositor->getPredictedDisplayTime(frameId);
+        }
+
+        ovrResult getPerfStats(ovrPerfStats& stats) override {
+            return m_compositor->getPerfStats(stats);
+        }
+
+        // Check the predicted display time returned to the application for a frame.
+        void checkPredictedDisplayTime(long long frameId, XrTime predictedDisplayTime) {
+            std::unique_lock lock(m_mutex);
+            if (m_lastPredictedDisplayTime && predictedDisplayTime <= m_lastPredictedDisplayTime.value()) {
+                report("Frame %lld predicted display time %lld is not after %lld\n",
+                       frameId,
+                       predictedDisplayTime,
+                       m_lastPredictedDisplayTime.value());
+            }
+            m_lastPredictedDisplayTime = predictedDisplayTime;
+        }
+
+        uint32_t getViolationCount() const {
+            return m_violationCount;
+        }
+
+      private:
+        template <typename... Args>
+        void report(const char* fmt, Args... args) {
+            m_violationCount++;
+            TraceLoggingWrite(log::g_traceProvider, "FrameLoopViolation", TLArg(m_lastWaited.value_or(-1), "Waited"));
+            log::ErrorLog(fmt, args...);
+        }
+
+        const std::unique_ptr<IFrameCompositor> m_compositor;
+
+        std::mutex m_mutex;
+        std::optional<long long> m_lastWaited;
+        std::optional<long long> m_lastBegun;
+        std::optional<long long> m_lastEnded;
+        std::optional<long long> m_lastDiscarded;
+        std::optional<XrTime> m_lastPredictedDisplayTime;
+        std::atomic<uint32_t> m_violationCount{0};
+    };
+
+    // Inject compositor-side conditions on top of another compositor, so the runtime's reactions to them (frame pacing,
+    // ASW prediction, running start, metrics) can be exercised on demand. The faults follow a fixed schedule in frames
+    // rather than wall time, so that a scenario always plays the same way for a given application.
+    // The runtime only enables it in debug builds. The unit tests run it on top of a simulated compositor, with a sleep
+    // function that advances their virtual clock.
+    class FaultInjectingFrameCompositor : public IFrameCompositor {
+      public:
+        enum Fault : uint32_t {
+            // ASW is reported as engaged for the whole session.
+            AswEngaged = 1 << 0,
+            // ASW is reported as engaging and disengaging every k_aswTogglePeriod frames.
+            AswToggling = 1 << 1,
+            // Every k_droppedFramePeriod frames, the wait is delayed by one refresh period and the frame is reported as
+            // dropped.
+            DroppedFrames = 1 << 2,
+            // Every k_compositorSpikePeriod frames, the compositor reports taking most of a refresh period.
+            CompositorSpikes = 1 << 3,
+        };
+
+        FaultInjectingFrameCompositor(std::unique_ptr<IFrameCompositor> compositor,
+                                      uint32_t faults,
+                                      double frameDuration,
+                                      std::function<void(double)> sleep = {})
+            : m_compositor(std::move(compositor)), m_faults(faults), m_frameDuration(frameDuration),
+              m_sleep(sleep ? std::move(sleep) : [](double duration) {
+                  std::this_thread::sleep_for(std::chrono::duration<double>(duration));
+              }) {
+        }
+
+        ovrResult waitToBeginFrame(long long frameId) override {
+            const ovrResult result = m_compositor->waitToBeginFrame(frameId);
+            if (OVR_SUCCESS(result) && (m_faults & DroppedFrames) && frameId % k_droppedFramePeriod == 0) {
+                TraceLoggingWrite(log::g_traceProvider, "InjectDroppedFrame", TLArg(frameId, "FrameId"));
+                m_sleep(m_frameDuration);
+                m_droppedFrameCount++;
+            }
+            m_lastFrameId = frameId;
+            return result;
+        }
+
+        ovrResult beginFrame(long long frameId) override {
+            return m_compositor->beginFrame(frameId);
+        }
+
+        void discardFrame(long long frameId) override {
+            m_compositor->discardFrame(frameId);
+        }
+
+        ovrResult endFrame(long long frameId,
+                           const ovrViewScaleDesc* viewScaleDesc,
+                           ovrLayerHeader const* const* layers,
+                           unsigned int layerCount) override {
+            return m_compositor->endFrame(frameId, viewScaleDesc, layers, layerCount);
+        }
+
+        double getPredictedDisplayTime(long long frameId) override {
+            return m_compositor->getPredictedDisplayTime(frameId);
+        }
+
+        ovrResult getPerfStats(ovrPerfStats& stats) override {
+            const ovrResult result = m_compositor->getPerfStats(stats);
+            if (OVR_FAILURE(result)) {
+                return result;
+            }
+
+            // Make sure there is a most recent frame to alter.
+            if (stats.FrameStatsCount == 0) {
+                stats.FrameStats[0] = {};
+                stats.FrameStatsCount = 1;
+            }
+            ovrPerfStatsPerCompositorFrame& frameStats = stats.FrameStats[0];
+
+            if ((m_faults & AswEngaged) || ((m_faults & AswToggling) && (m_lastFrameId / k_aswTogglePeriod) % 2)) {
+                stats.AswIsAvailable = ovrTrue;
+                frameStats.AswIsActive = ovrTrue;
+            }
+            if (m_faults & DroppedFrames) {
+                frameStats.AppDroppedFrameCount += m_droppedFrameCount;
+            }
+            if ((m_faults & CompositorSpikes) && m_lastFrameId % k_compositorSpikePeriod == 0) {
+                frameStats.CompositorCpuStartToGpuEndElapsedTime = (float)(m_frameDuration * 0.8);
+            }
+
+            return result;
+        }
+
+      private:
+        static constexpr long long k_aswTogglePeriod = 300;
+        static constexpr long long k_droppedFramePeriod = 97;
+        static constexpr long long k_compositorSpikePeriod = 50;
+
+        const std::unique_ptr<IFrameCompositor> m_compositor;
+        const uint32_t m_faults;
+        const double m_frameDuration;
+        const std::function<void(double)> m_sleep;
+
+        // waitToBeginFrame() and getPerfStats() may be called from different threads.
+        std::atomic<long long> m_lastFrameId{0};
+        std::atomic<int> m_droppedFrameCount{0};
+    };
+
+} // namespace virtualdesktop_openxr
@@ -0,0 +1,189 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "pch.h"
+
+namespace virtualdesktop_openxr::utils {
+
+    // The timings recorded for each frame. Durations are in microseconds. Since the measurements do not all complete
+    // at the same time (eg: GPU timers lag by a few frames), each field holds the latest measurement known when the
+    // frame was submitted.
+    struct FrameMetrics {
+        uint64_t frameId;
+        float waitTime;       // Time blocked in xrWaitFrame().
+        float appCpuTime;     // From xrWaitFrame() to the next xrWaitFrame().
+        float appGpuTime;     // App GPU work between xrBeginFrame() and xrEndFrame().
+        float compositorTime; // Compositor CPU start to GPU end.
+        float endFrameTime;   // From entering xrEndFrame() to the layers being handed off for submission.
+        uint32_t droppedFrames; // Total frames dropped by the compositor since the session started.
+        uint8_t layerCount;
+        bool isAsyncReprojectionActive;
+    };
+
+    // A histogram with logarithmic buckets, each subdivided linearly (like HdrHistogram). Values up to 2^32 are
+    // recorded with a relative error below 2^-k_subBucketBits.
+    class LogHistogram {
+      public:
+        static constexpr uint32_t k_subBucketBits = 6;
+        static constexpr uint32_t k_numBuckets = (32 - k_subBucketBits + 1) * (1u << (k_subBucketBits - 1)) +
+                                                 (1u << (k_subBucketBits - 1));
+
+        void record(uint32_t value) {
+            m_counts[indexOf(value)]++;
+            m_totalCount++;
+            m_max = std::max(m_max, value);
+        }
+
+        void clear() {
+            std::fill(std::begin(m_counts), std::end(m_counts), 0);
+            m_totalCount = 0;
+            m_max = 0;
+        }
+
+        uint64_t getTotalCount() const {
+            return m_totalCount;
+        }
+
+        uint32_t getMax() const {
+            return m_max;
+        }
+
+        // The percentile is in [0, 1]. Returns the midpoint of the bucket holding it.
+        uint32_t getPercentile(double percentile) const {
+            if (!m_totalCount) {
+                return 0;
+            }
+            if (percentile >= 1.0) {
+                return m_max;
+            }
+
+            const uint64_t rank = std::max((uint64_t)std::ceil(percentile * m_totalCount), (uint64_t)1);
+            uint64_t count = 0;
+            for (uint32_t i = 0; i < k_numBuckets; i++) {
+                count += m_counts[i];
+                if (count >= rank) {
+                    return std::min(midpointOf(i), m_max);
+                }
+            }
+            return m_max;
+        }
+
+      private:
+        static uint32_t magnitudeOf(uint32_t value) {
+            uint32_t msb = 0;
+            for (; value > 1; value >>= 1) {
+                msb++;
+            }
+            return msb < k_subBucketBits ? 0 : msb - k_subBucketBits + 1;
+        }
+
+        static uint32_t indexOf(uint32_t value) {
+            const uint32_t magnitude = magnitudeOf(value);
+            return (magnitude << (k_subBucketBits - 1)) + (value >> magnitude);
+        }
+
+        static uint32_t midpointOf(uint32_t index) {
+            const uint32_t magnitude = index < (1u << k_subBucketBits) ? 0 : (index >> (k_subBucketBits - 1)) - 1;
+            const uint64_t lowest = (uint64_t)(index - (magnitude << (k_subBucketBits - 1))) << magnitude;
+            return (uint32_t)std::min(lowest + (((uint64_t)1 << magnitude) >> 1), (uint64_t)UINT32_MAX);
+        }
+
+        uint32_t m_counts[k_numBuckets]{};
+        uint64_t m_totalCount{0};
+        uint32_t m_max{0};
+    };
+
+    // Keep the metrics for the most recent frames, and the distribution of the timings over the whole session.
+    class FrameMetricsRecorder {
+      public:
+        static constexpr size_t k_capacity = 4096;
+
+        void record(const FrameMetrics& metrics) {
+            m_frames[m_nextFrame] = metrics;
+            m_nextFrame = (m_nextFrame + 1) % k_capacity;
+            m_numFrames = std::min(m_numFrames + 1, k_capacity);
+
+            m_histograms[WaitTime].record((uint32_t)metrics.waitTime);
+            m_histograms[AppCpuTime].record((uint32_t)metrics.appCpuTime);
+            m_histograms[AppGpuTime].record((uint32_t)metrics.appGpuTime);
+            m_histograms[CompositorTime].record((uint32_t)metrics.compositorTime);
+            m_histograms[EndFrameTime].record((uint32_t)metrics.endFrameTime);
+
+            if (m_totalFrames == 0) {
+                m_initialDroppedFrames = metrics.droppedFrames;
+            }
+            m_lastDroppedFrames = metrics.droppedFrames;
+            m_totalFrames++;
+        }
+
+        void clear() {
+            m_nextFrame = m_numFrames = 0;
+            for (auto& histogram : m_histograms) {
+                histogram.clear();
+            }
+            m_totalFrames = 0;
+            m_initialDroppedFrames = m_lastDroppedFrames = 0;
+        }
+
+        // One line per frame, oldest first.
+        void writeCsv(std::ostream& out) const {
+            out << "frameId,waitTimeUs,appCpuTimeUs,appGpuTimeUs,compositorTimeUs,endFrameTimeUs,droppedFrames,"
+                   "layerCount,asyncReprojection\n";
+            for (size_t i = 0; i < m_numFrames; i++) {
+                const FrameMetrics& frame = m_frames[(m_nextFrame + k_capacity - m_numFrames + i) % k_capacity];
+                out << frame.frameId << ',' << frame.waitTime << ',' << frame.appCpuTime << ',' << frame.appGpuTime
+                    << ',' << frame.compositorTime << ',' << frame.endFrameTime << ',' << frame.droppedFrames << ','
+                    << (uint32_t)frame.layerCount << ',' << (frame.isAsyncReprojectionActive ? 1 : 0) << '\n';
+            }
+        }
+
+        // The distribution of each timing over the whole session.
+        void writeJson(std::ostream& out) const {
+            out << "{\n  \"frames\": " << m_totalFrames
+                << ",\n  \"droppedFrames\": " << (m_lastDroppedFrames - m_initialDroppedFrames);
+            for (uint32_t i = 0; i < Count; i++) {
+                const LogHistogram& histogram = m_histograms[i];
+                out << ",\n  \"" << k_metricNames[i] << "\": {\"p50\": " << histogram.getPercentile(0.5)
+                    << ", \"p95\": " << histogram.getPercentile(0.95) << ", \"p99\": " << histogram.getPercentile(0.99)
+                    << ", \"max\": " << histogram.getMax() << "}";
+            }
+            out << "\n}\n";
+        }
+
+      private:
+        enum Metric { WaitTime = 0, AppCpuTime, AppGpuTime, CompositorTime, EndFrameTime, Count };
+        static constexpr const char* k_metricNames[Count] = {
+            "waitTimeUs", "appCpuTimeUs", "appGpuTimeUs", "compositorTimeUs", "endFrameTimeUs"};
+
+        FrameMetrics m_frames[k_capacity]{};
+        size_t m_nextFrame{0};
+        size_t m_numFrames{0};
+
+        LogHistogram m_histograms[Count];
+        uint64_t m_totalFrames{0};
+        uint32_t m_initialDroppedFrames{0};
+        uint32_t m_lastDroppedFrames{0};
+    };
+
+} // namespace virtualdesktop_openxr::utils
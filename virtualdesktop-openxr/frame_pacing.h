@@ -0,0 +1,204 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "pch.h"
+
+namespace virtualdesktop_openxr::utils {
+
+    // Estimate an upcoming duration (in seconds) from the recent history.
+    struct IDurationEstimator {
+        virtual ~IDurationEstimator() = default;
+
+        virtual void addSample(double duration) = 0;
+        virtual double estimate() const = 0;
+    };
+
+    // Exponentially-weighted moving average, padded with the average deviation to cover most of the jitter.
+    class EwmaEstimator : public IDurationEstimator {
+      public:
+        EwmaEstimator(double alpha = 0.1, double deviations = 2.0) : m_alpha(alpha), m_deviations(deviations) {
+        }
+
+        void addSample(double duration) override {
+            if (!m_hasSamples) {
+                m_mean = duration;
+                m_deviation = 0.0;
+                m_hasSamples = true;
+                return;
+            }
+
+            m_deviation += m_alpha * (std::abs(duration - m_mean) - m_deviation);
+            m_mean += m_alpha * (duration - m_mean);
+        }
+
+        double estimate() const override {
+            return m_mean + m_deviations * m_deviation;
+        }
+
+      private:
+        const double m_alpha;
+        const double m_deviations;
+
+        bool m_hasSamples{false};
+        double m_mean{0.0};
+        double m_deviation{0.0};
+    };
+
+    // Percentile over a sliding window. Slower to react than the EWMA, but not thrown off by isolated spikes.
+    class PercentileEstimator : public IDurationEstimator {
+      public:
+        static constexpr size_t k_windowSize = 64;
+
+        PercentileEstimator(double percentile = 0.9) : m_percentile(percentile) {
+        }
+
+        void addSample(double duration) override {
+            m_samples[m_nextSample] = duration;
+            m_nextSample = (m_nextSample + 1) % k_windowSize;
+            m_numSamples = std::min(m_numSamples + 1, k_windowSize);
+        }
+
+        double estimate() const override {
+            if (!m_numSamples) {
+                return 0.0;
+            }
+
+            double sorted[k_windowSize];
+            std::copy_n(m_samples, m_numSamples, sorted);
+            const size_t index = std::min((size_t)(m_percentile * m_numSamples), m_numSamples - 1);
+            std::nth_element(sorted, sorted + index, sorted + m_numSamples);
+            return sorted[index];
+        }
+
+      private:
+        const double m_percentile;
+
+        double m_samples[k_windowSize]{};
+        size_t m_nextSample{0};
+        size_t m_numSamples{0};
+    };
+
+    enum class RunningStartPolicy {
+        Fixed = 0,
+        Ewma,
+        Percentile,
+    };
+
+    // Choose how early to wake up xrWaitFrame() ahead of the compositor being ready for the next frame (aka "running
+    // start"). Waking up earlier gives the app more time to complete its frame, at the cost of added latency.
+    // The controller is only fed with measured durations, and it does not read any clock by itself.
+    class RunningStartController {
+      public:
+        // The historical value, which is also the smallest offset we will ever use.
+        static constexpr double k_fixedOffset = 0.002;
+        static constexpr double k_safetyMargin = 0.001;
+
+        RunningStartController() {
+            setPolicy(RunningStartPolicy::Ewma);
+        }
+
+        // Unknown policies fall back to the fixed offset.
+        void setPolicy(RunningStartPolicy policy) {
+            if (policy != RunningStartPolicy::Ewma && policy != RunningStartPolicy::Percentile) {
+                policy = RunningStartPolicy::Fixed;
+            }
+            if (policy == m_policy) {
+                return;
+            }
+
+            m_policy = policy;
+            for (auto& estimator : m_estimators) {
+                switch (policy) {
+                case RunningStartPolicy::Ewma:
+                    estimator = std::make_unique<EwmaEstimator>();
+                    break;
+                case RunningStartPolicy::Percentile:
+                    estimator = std::make_unique<PercentileEstimator>();
+                    break;
+                default:
+                    estimator.reset();
+                    break;
+                }
+            }
+            m_offset = k_fixedOffset;
+        }
+
+        // Record the timings for the last frame, and compute the offset for the next one. Durations are in seconds,
+        // and 0 denotes an unknown duration.
+        void update(double appCpuTime, double appGpuTime, double compositorTime, double frameDuration) {
+            if (m_policy == RunningStartPolicy::Fixed) {
+                m_offset = k_fixedOffset;
+                return;
+            }
+
+            // Unknown durations would drag the estimates down.
+            if (appCpuTime > 0) {
+                m_estimators[AppCpu]->addSample(appCpuTime);
+            }
+            if (appGpuTime > 0) {
+                m_estimators[AppGpu]->addSample(appGpuTime);
+            }
+            if (compositorTime > 0) {
+                m_estimators[Compositor]->addSample(compositorTime);
+            }
+
+            // CPU and GPU work of consecutive frames overlap, so the critical path is the longest of the two. The app
+            // must complete it before the compositor starts working on the frame.
+            const double appTime = std::max(getAppCpuEstimate(), getAppGpuEstimate());
+            const double budget = frameDuration - getCompositorEstimate();
+            const double neededOffset = appTime + k_safetyMargin - budget;
+
+            // Past half a frame, waking up earlier would mostly cause the app to wait in xrBeginFrame().
+            m_offset = std::clamp(neededOffset, k_fixedOffset, std::max(frameDuration / 2, k_fixedOffset));
+        }
+
+        double getOffset() const {
+            return m_offset;
+        }
+
+        RunningStartPolicy getPolicy() const {
+            return m_policy;
+        }
+
+        double getAppCpuEstimate() const {
+            return m_estimators[AppCpu] ? m_estimators[AppCpu]->estimate() : 0.0;
+        }
+
+        double getAppGpuEstimate() const {
+            return m_estimators[AppGpu] ? m_estimators[AppGpu]->estimate() : 0.0;
+        }
+
+        double getCompositorEstimate() const {
+            return m_estimators[Compositor] ? m_estimators[Compositor]->estimate() : 0.0;
+        }
+
+      private:
+        enum Estimate { AppCpu = 0, AppGpu, Compositor, Count };
+
+        RunningStartPolicy m_policy{RunningStartPolicy::Fixed};
+        std::unique_ptr<IDurationEstimator> m_estimators[Estimate::Count];
+        double m_offset{k_fixedOffset};
+    };
+
+} // namespace virtualdesktop_openxr::utils
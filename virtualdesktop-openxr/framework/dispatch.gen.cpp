@@ -1867,284 +1867,569 @@ namespace RUNTIME_NAMESPACE {
 
 
 	// Auto-generated dispatcher handler.
+	namespace {
+		// FNV-1a, with a seed. Must match hashCommandName() in dispatch_generator.py.
+		constexpr uint32_t hashCommandName(std::string_view name, uint32_t seed) {
+			uint32_t hash = 2166136261u ^ seed;
+			for (const char c : name) {
+				hash = (hash ^ (uint8_t)c) * 16777619u;
+			}
+			return hash;
+		}
+	} // namespace
+
 	XrResult OpenXrApi::xrGetInstanceProcAddr(XrInstance instance, const char* name, PFN_xrVoidFunction* function) {
 		const std::string_view apiName(name);
 
-		if (apiName == "xrGetInstanceProcAddr") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetInstanceProcAddr);
-		}
-		else if (apiName == "xrEnumerateInstanceExtensionProperties") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrEnumerateInstanceExtensionProperties);
-		}
-		else if (apiName == "xrCreateInstance") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrCreateInstance);
-		}
-		else if (apiName == "xrDestroyInstance") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrDestroyInstance);
-		}
-		else if (apiName == "xrGetInstanceProperties") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetInstanceProperties);
-		}
-		else if (apiName == "xrPollEvent") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrPollEvent);
-		}
-		else if (apiName == "xrResultToString") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrResultToString);
-		}
-		else if (apiName == "xrStructureTypeToString") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrStructureTypeToString);
-		}
-		else if (apiName == "xrGetSystem") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetSystem);
-		}
-		else if (apiName == "xrGetSystemProperties") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetSystemProperties);
-		}
-		else if (apiName == "xrEnumerateEnvironmentBlendModes") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrEnumerateEnvironmentBlendModes);
-		}
-		else if (apiName == "xrCreateSession") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrCreateSession);
-		}
-		else if (apiName == "xrDestroySession") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrDestroySession);
-		}
-		else if (apiName == "xrEnumerateReferenceSpaces") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrEnumerateReferenceSpaces);
-		}
-		else if (apiName == "xrCreateReferenceSpace") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrCreateReferenceSpace);
-		}
-		else if (apiName == "xrGetReferenceSpaceBoundsRect") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetReferenceSpaceBoundsRect);
-		}
-		else if (apiName == "xrCreateActionSpace") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrCreateActionSpace);
-		}
-		else if (apiName == "xrLocateSpace") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrLocateSpace);
-		}
-		else if (apiName == "xrDestroySpace") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrDestroySpace);
-		}
-		else if (apiName == "xrEnumerateViewConfigurations") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrEnumerateViewConfigurations);
-		}
-		else if (apiName == "xrGetViewConfigurationProperties") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetViewConfigurationProperties);
-		}
-		else if (apiName == "xrEnumerateViewConfigurationViews") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrEnumerateViewConfigurationViews);
-		}
-		else if (apiName == "xrEnumerateSwapchainFormats") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrEnumerateSwapchainFormats);
-		}
-		else if (apiName == "xrCreateSwapchain") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrCreateSwapchain);
-		}
-		else if (apiName == "xrDestroySwapchain") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrDestroySwapchain);
-		}
-		else if (apiName == "xrEnumerateSwapchainImages") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrEnumerateSwapchainImages);
-		}
-		else if (apiName == "xrAcquireSwapchainImage") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrAcquireSwapchainImage);
-		}
-		else if (apiName == "xrWaitSwapchainImage") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrWaitSwapchainImage);
-		}
-		else if (apiName == "xrReleaseSwapchainImage") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrReleaseSwapchainImage);
-		}
-		else if (apiName == "xrBeginSession") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrBeginSession);
-		}
-		else if (apiName == "xrEndSession") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrEndSession);
-		}
-		else if (apiName == "xrRequestExitSession") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrRequestExitSession);
-		}
-		else if (apiName == "xrWaitFrame") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrWaitFrame);
-		}
-		else if (apiName == "xrBeginFrame") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrBeginFrame);
-		}
-		else if (apiName == "xrEndFrame") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrEndFrame);
-		}
-		else if (apiName == "xrLocateViews") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrLocateViews);
-		}
-		else if (apiName == "xrStringToPath") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrStringToPath);
-		}
-		else if (apiName == "xrPathToString") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrPathToString);
-		}
-		else if (apiName == "xrCreateActionSet") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrCreateActionSet);
-		}
-		else if (apiName == "xrDestroyActionSet") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrDestroyActionSet);
-		}
-		else if (apiName == "xrCreateAction") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrCreateAction);
-		}
-		else if (apiName == "xrDestroyAction") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrDestroyAction);
-		}
-		else if (apiName == "xrSuggestInteractionProfileBindings") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrSuggestInteractionProfileBindings);
-		}
-		else if (apiName == "xrAttachSessionActionSets") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrAttachSessionActionSets);
-		}
-		else if (apiName == "xrGetCurrentInteractionProfile") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetCurrentInteractionProfile);
-		}
-		else if (apiName == "xrGetActionStateBoolean") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetActionStateBoolean);
-		}
-		else if (apiName == "xrGetActionStateFloat") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetActionStateFloat);
-		}
-		else if (apiName == "xrGetActionStateVector2f") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetActionStateVector2f);
-		}
-		else if (apiName == "xrGetActionStatePose") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetActionStatePose);
-		}
-		else if (apiName == "xrSyncActions") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrSyncActions);
-		}
-		else if (apiName == "xrEnumerateBoundSourcesForAction") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrEnumerateBoundSourcesForAction);
-		}
-		else if (apiName == "xrGetInputSourceLocalizedName") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetInputSourceLocalizedName);
-		}
-		else if (apiName == "xrApplyHapticFeedback") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrApplyHapticFeedback);
-		}
-		else if (apiName == "xrStopHapticFeedback") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrStopHapticFeedback);
-		}
-		else if (has_XR_KHR_opengl_enable && apiName == "xrGetOpenGLGraphicsRequirementsKHR") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetOpenGLGraphicsRequirementsKHR);
-		}
-		else if (has_XR_KHR_vulkan_enable && apiName == "xrGetVulkanInstanceExtensionsKHR") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetVulkanInstanceExtensionsKHR);
-		}
-		else if (has_XR_KHR_vulkan_enable && apiName == "xrGetVulkanDeviceExtensionsKHR") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetVulkanDeviceExtensionsKHR);
-		}
-		else if (has_XR_KHR_vulkan_enable && apiName == "xrGetVulkanGraphicsDeviceKHR") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetVulkanGraphicsDeviceKHR);
-		}
-		else if (has_XR_KHR_vulkan_enable && apiName == "xrGetVulkanGraphicsRequirementsKHR") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetVulkanGraphicsRequirementsKHR);
-		}
-		else if (has_XR_KHR_D3D11_enable && apiName == "xrGetD3D11GraphicsRequirementsKHR") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetD3D11GraphicsRequirementsKHR);
-		}
-		else if (has_XR_KHR_D3D12_enable && apiName == "xrGetD3D12GraphicsRequirementsKHR") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetD3D12GraphicsRequirementsKHR);
-		}
-		else if (has_XR_KHR_visibility_mask && apiName == "xrGetVisibilityMaskKHR") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetVisibilityMaskKHR);
-		}
-		else if (has_XR_KHR_win32_convert_performance_counter_time && apiName == "xrConvertWin32PerformanceCounterToTimeKHR") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrConvertWin32PerformanceCounterToTimeKHR);
-		}
-		else if (has_XR_KHR_win32_convert_performance_counter_time && apiName == "xrConvertTimeToWin32PerformanceCounterKHR") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrConvertTimeToWin32PerformanceCounterKHR);
-		}
-		else if (has_XR_KHR_vulkan_enable2 && apiName == "xrCreateVulkanInstanceKHR") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrCreateVulkanInstanceKHR);
-		}
-		else if (has_XR_KHR_vulkan_enable2 && apiName == "xrCreateVulkanDeviceKHR") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrCreateVulkanDeviceKHR);
-		}
-		else if (has_XR_KHR_vulkan_enable2 && apiName == "xrGetVulkanGraphicsDevice2KHR") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetVulkanGraphicsDevice2KHR);
-		}
-		else if (has_XR_KHR_vulkan_enable2 && apiName == "xrGetVulkanGraphicsRequirements2KHR") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetVulkanGraphicsRequirements2KHR);
-		}
-		else if (has_XR_EXT_hand_tracking && apiName == "xrCreateHandTrackerEXT") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrCreateHandTrackerEXT);
-		}
-		else if (has_XR_EXT_hand_tracking && apiName == "xrDestroyHandTrackerEXT") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrDestroyHandTrackerEXT);
-		}
-		else if (has_XR_EXT_hand_tracking && apiName == "xrLocateHandJointsEXT") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrLocateHandJointsEXT);
-		}
-		else if (has_XR_FB_body_tracking && apiName == "xrCreateBodyTrackerFB") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrCreateBodyTrackerFB);
-		}
-		else if (has_XR_FB_body_tracking && apiName == "xrDestroyBodyTrackerFB") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrDestroyBodyTrackerFB);
-		}
-		else if (has_XR_FB_body_tracking && apiName == "xrLocateBodyJointsFB") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrLocateBodyJointsFB);
-		}
-		else if (has_XR_FB_body_tracking && apiName == "xrGetBodySkeletonFB") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetBodySkeletonFB);
-		}
-		else if (has_XR_FB_display_refresh_rate && apiName == "xrEnumerateDisplayRefreshRatesFB") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrEnumerateDisplayRefreshRatesFB);
-		}
-		else if (has_XR_FB_display_refresh_rate && apiName == "xrGetDisplayRefreshRateFB") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetDisplayRefreshRateFB);
-		}
-		else if (has_XR_FB_display_refresh_rate && apiName == "xrRequestDisplayRefreshRateFB") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrRequestDisplayRefreshRateFB);
-		}
-		else if (has_XR_HTCX_vive_tracker_interaction && apiName == "xrEnumerateViveTrackerPathsHTCX") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrEnumerateViveTrackerPathsHTCX);
-		}
-		else if (has_XR_OCULUS_audio_device_guid && apiName == "xrGetAudioOutputDeviceGuidOculus") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetAudioOutputDeviceGuidOculus);
-		}
-		else if (has_XR_OCULUS_audio_device_guid && apiName == "xrGetAudioInputDeviceGuidOculus") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetAudioInputDeviceGuidOculus);
-		}
-		else if (has_XR_FB_face_tracking && apiName == "xrCreateFaceTrackerFB") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrCreateFaceTrackerFB);
-		}
-		else if (has_XR_FB_face_tracking && apiName == "xrDestroyFaceTrackerFB") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrDestroyFaceTrackerFB);
-		}
-		else if (has_XR_FB_face_tracking && apiName == "xrGetFaceExpressionWeightsFB") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetFaceExpressionWeightsFB);
-		}
-		else if (has_XR_FB_eye_tracking_social && apiName == "xrCreateEyeTrackerFB") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrCreateEyeTrackerFB);
-		}
-		else if (has_XR_FB_eye_tracking_social && apiName == "xrDestroyEyeTrackerFB") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrDestroyEyeTrackerFB);
-		}
-		else if (has_XR_FB_eye_tracking_social && apiName == "xrGetEyeGazesFB") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetEyeGazesFB);
-		}
-		else if (has_XR_FB_face_tracking2 && apiName == "xrCreateFaceTracker2FB") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrCreateFaceTracker2FB);
-		}
-		else if (has_XR_FB_face_tracking2 && apiName == "xrDestroyFaceTracker2FB") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrDestroyFaceTracker2FB);
-		}
-		else if (has_XR_FB_face_tracking2 && apiName == "xrGetFaceExpressionWeights2FB") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetFaceExpressionWeights2FB);
-		}
-		else {
-			return XR_ERROR_FUNCTION_UNSUPPORTED;
-		}
-
-		return XR_SUCCESS;
+		// Perfect hash (hash and displace) over the command names, so that only one string comparison is needed.
+		static constexpr uint32_t displacements[22] = {96, 164, 1, 10, 5, 4, 42, 20, 14, 13, 2, 2, 2, 44, 21, 2, 16, 1, 60, 104, 0, 7};
+		const uint32_t bucket = hashCommandName(apiName, 0) % 22;
+		const uint32_t slot = hashCommandName(apiName, displacements[bucket]) % 112;
+
+		switch (slot) {
+		case 0:
+			if (has_XR_FB_display_refresh_rate && apiName == "xrGetDisplayRefreshRateFB") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetDisplayRefreshRateFB);
+				return XR_SUCCESS;
+			}
+			break;
+		case 1:
+			if (apiName == "xrAttachSessionActionSets") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrAttachSessionActionSets);
+				return XR_SUCCESS;
+			}
+			break;
+		case 2:
+			if (apiName == "xrGetActionStateFloat") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetActionStateFloat);
+				return XR_SUCCESS;
+			}
+			break;
+		case 3:
+			if (has_XR_FB_display_refresh_rate && apiName == "xrEnumerateDisplayRefreshRatesFB") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrEnumerateDisplayRefreshRatesFB);
+				return XR_SUCCESS;
+			}
+			break;
+		case 4:
+			if (apiName == "xrDestroySession") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrDestroySession);
+				return XR_SUCCESS;
+			}
+			break;
+		case 5:
+			if (apiName == "xrEndFrame") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrEndFrame);
+				return XR_SUCCESS;
+			}
+			break;
+		case 6:
+			if (has_XR_FB_body_tracking && apiName == "xrLocateBodyJointsFB") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrLocateBodyJointsFB);
+				return XR_SUCCESS;
+			}
+			break;
+		case 7:
+			if (apiName == "xrCreateSession") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrCreateSession);
+				return XR_SUCCESS;
+			}
+			break;
+		case 8:
+			if (has_XR_FB_face_tracking && apiName == "xrDestroyFaceTrackerFB") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrDestroyFaceTrackerFB);
+				return XR_SUCCESS;
+			}
+			break;
+		case 9:
+			if (apiName == "xrPollEvent") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrPollEvent);
+				return XR_SUCCESS;
+			}
+			break;
+		case 10:
+			if (has_XR_FB_face_tracking2 && apiName == "xrCreateFaceTracker2FB") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrCreateFaceTracker2FB);
+				return XR_SUCCESS;
+			}
+			break;
+		case 11:
+			if (apiName == "xrGetInputSourceLocalizedName") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetInputSourceLocalizedName);
+				return XR_SUCCESS;
+			}
+			break;
+		case 12:
+			if (apiName == "xrEnumerateViewConfigurationViews") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrEnumerateViewConfigurationViews);
+				return XR_SUCCESS;
+			}
+			break;
+		case 13:
+			if (has_XR_KHR_D3D11_enable && apiName == "xrGetD3D11GraphicsRequirementsKHR") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetD3D11GraphicsRequirementsKHR);
+				return XR_SUCCESS;
+			}
+			break;
+		case 14:
+			if (apiName == "xrGetCurrentInteractionProfile") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetCurrentInteractionProfile);
+				return XR_SUCCESS;
+			}
+			break;
+		case 16:
+			if (apiName == "xrBeginFrame") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrBeginFrame);
+				return XR_SUCCESS;
+			}
+			break;
+		case 17:
+			if (apiName == "xrEnumerateSwapchainImages") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrEnumerateSwapchainImages);
+				return XR_SUCCESS;
+			}
+			break;
+		case 18:
+			if (apiName == "xrCreateSwapchain") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrCreateSwapchain);
+				return XR_SUCCESS;
+			}
+			break;
+		case 19:
+			if (has_XR_FB_face_tracking2 && apiName == "xrGetFaceExpressionWeights2FB") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetFaceExpressionWeights2FB);
+				return XR_SUCCESS;
+			}
+			break;
+		case 20:
+			if (has_XR_FB_eye_tracking_social && apiName == "xrDestroyEyeTrackerFB") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrDestroyEyeTrackerFB);
+				return XR_SUCCESS;
+			}
+			break;
+		case 21:
+			if (has_XR_KHR_win32_convert_performance_counter_time && apiName == "xrConvertWin32PerformanceCounterToTimeKHR") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrConvertWin32PerformanceCounterToTimeKHR);
+				return XR_SUCCESS;
+			}
+			break;
+		case 24:
+			if (apiName == "xrStringToPath") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrStringToPath);
+				return XR_SUCCESS;
+			}
+			break;
+		case 26:
+			if (has_XR_KHR_D3D12_enable && apiName == "xrGetD3D12GraphicsRequirementsKHR") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetD3D12GraphicsRequirementsKHR);
+				return XR_SUCCESS;
+			}
+			break;
+		case 27:
+			if (apiName == "xrGetSystemProperties") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetSystemProperties);
+				return XR_SUCCESS;
+			}
+			break;
+		case 29:
+			if (apiName == "xrGetInstanceProcAddr") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetInstanceProcAddr);
+				return XR_SUCCESS;
+			}
+			break;
+		case 30:
+			if (apiName == "xrGetSystem") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetSystem);
+				return XR_SUCCESS;
+			}
+			break;
+		case 31:
+			if (apiName == "xrEnumerateSwapchainFormats") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrEnumerateSwapchainFormats);
+				return XR_SUCCESS;
+			}
+			break;
+		case 32:
+			if (has_XR_FB_body_tracking && apiName == "xrGetBodySkeletonFB") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetBodySkeletonFB);
+				return XR_SUCCESS;
+			}
+			break;
+		case 34:
+			if (has_XR_FB_face_tracking && apiName == "xrGetFaceExpressionWeightsFB") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetFaceExpressionWeightsFB);
+				return XR_SUCCESS;
+			}
+			break;
+		case 37:
+			if (apiName == "xrEndSession") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrEndSession);
+				return XR_SUCCESS;
+			}
+			break;
+		case 38:
+			if (apiName == "xrStructureTypeToString") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrStructureTypeToString);
+				return XR_SUCCESS;
+			}
+			break;
+		case 39:
+			if (apiName == "xrGetReferenceSpaceBoundsRect") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetReferenceSpaceBoundsRect);
+				return XR_SUCCESS;
+			}
+			break;
+		case 40:
+			if (apiName == "xrSuggestInteractionProfileBindings") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrSuggestInteractionProfileBindings);
+				return XR_SUCCESS;
+			}
+			break;
+		case 41:
+			if (apiName == "xrCreateActionSpace") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrCreateActionSpace);
+				return XR_SUCCESS;
+			}
+			break;
+		case 42:
+			if (has_XR_FB_body_tracking && apiName == "xrCreateBodyTrackerFB") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrCreateBodyTrackerFB);
+				return XR_SUCCESS;
+			}
+			break;
+		case 43:
+			if (has_XR_KHR_vulkan_enable2 && apiName == "xrGetVulkanGraphicsDevice2KHR") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetVulkanGraphicsDevice2KHR);
+				return XR_SUCCESS;
+			}
+			break;
+		case 44:
+			if (apiName == "xrEnumerateReferenceSpaces") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrEnumerateReferenceSpaces);
+				return XR_SUCCESS;
+			}
+			break;
+		case 45:
+			if (has_XR_EXT_hand_tracking && apiName == "xrDestroyHandTrackerEXT") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrDestroyHandTrackerEXT);
+				return XR_SUCCESS;
+			}
+			break;
+		case 46:
+			if (apiName == "xrCreateReferenceSpace") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrCreateReferenceSpace);
+				return XR_SUCCESS;
+			}
+			break;
+		case 47:
+			if (apiName == "xrDestroyActionSet") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrDestroyActionSet);
+				return XR_SUCCESS;
+			}
+			break;
+		case 49:
+			if (apiName == "xrLocateViews") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrLocateViews);
+				return XR_SUCCESS;
+			}
+			break;
+		case 50:
+			if (has_XR_HTCX_vive_tracker_interaction && apiName == "xrEnumerateViveTrackerPathsHTCX") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrEnumerateViveTrackerPathsHTCX);
+				return XR_SUCCESS;
+			}
+			break;
+		case 51:
+			if (apiName == "xrWaitFrame") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrWaitFrame);
+				return XR_SUCCESS;
+			}
+			break;
+		case 52:
+			if (has_XR_KHR_vulkan_enable2 && apiName == "xrCreateVulkanDeviceKHR") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrCreateVulkanDeviceKHR);
+				return XR_SUCCESS;
+			}
+			break;
+		case 53:
+			if (apiName == "xrEnumerateInstanceExtensionProperties") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrEnumerateInstanceExtensionProperties);
+				return XR_SUCCESS;
+			}
+			break;
+		case 56:
+			if (has_XR_FB_face_tracking && apiName == "xrCreateFaceTrackerFB") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrCreateFaceTrackerFB);
+				return XR_SUCCESS;
+			}
+			break;
+		case 57:
+			if (has_XR_OCULUS_audio_device_guid && apiName == "xrGetAudioInputDeviceGuidOculus") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetAudioInputDeviceGuidOculus);
+				return XR_SUCCESS;
+			}
+			break;
+		case 58:
+			if (has_XR_KHR_vulkan_enable2 && apiName == "xrGetVulkanGraphicsRequirements2KHR") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetVulkanGraphicsRequirements2KHR);
+				return XR_SUCCESS;
+			}
+			break;
+		case 59:
+			if (apiName == "xrStopHapticFeedback") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrStopHapticFeedback);
+				return XR_SUCCESS;
+			}
+			break;
+		case 61:
+			if (apiName == "xrDestroyAction") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrDestroyAction);
+				return XR_SUCCESS;
+			}
+			break;
+		case 62:
+			if (apiName == "xrBeginSession") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrBeginSession);
+				return XR_SUCCESS;
+			}
+			break;
+		case 64:
+			if (apiName == "xrLocateSpace") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrLocateSpace);
+				return XR_SUCCESS;
+			}
+			break;
+		case 65:
+			if (has_XR_KHR_vulkan_enable2 && apiName == "xrCreateVulkanInstanceKHR") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrCreateVulkanInstanceKHR);
+				return XR_SUCCESS;
+			}
+			break;
+		case 66:
+			if (apiName == "xrDestroySpace") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrDestroySpace);
+				return XR_SUCCESS;
+			}
+			break;
+		case 67:
+			if (apiName == "xrGetActionStateBoolean") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetActionStateBoolean);
+				return XR_SUCCESS;
+			}
+			break;
+		case 69:
+			if (has_XR_KHR_win32_convert_performance_counter_time && apiName == "xrConvertTimeToWin32PerformanceCounterKHR") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrConvertTimeToWin32PerformanceCounterKHR);
+				return XR_SUCCESS;
+			}
+			break;
+		case 70:
+			if (has_XR_KHR_vulkan_enable && apiName == "xrGetVulkanDeviceExtensionsKHR") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetVulkanDeviceExtensionsKHR);
+				return XR_SUCCESS;
+			}
+			break;
+		case 71:
+			if (apiName == "xrCreateActionSet") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrCreateActionSet);
+				return XR_SUCCESS;
+			}
+			break;
+		case 73:
+			if (apiName == "xrPathToString") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrPathToString);
+				return XR_SUCCESS;
+			}
+			break;
+		case 74:
+			if (apiName == "xrSyncActions") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrSyncActions);
+				return XR_SUCCESS;
+			}
+			break;
+		case 75:
+			if (has_XR_KHR_vulkan_enable && apiName == "xrGetVulkanInstanceExtensionsKHR") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetVulkanInstanceExtensionsKHR);
+				return XR_SUCCESS;
+			}
+			break;
+		case 76:
+			if (apiName == "xrDestroyInstance") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrDestroyInstance);
+				return XR_SUCCESS;
+			}
+			break;
+		case 77:
+			if (apiName == "xrReleaseSwapchainImage") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrReleaseSwapchainImage);
+				return XR_SUCCESS;
+			}
+			break;
+		case 78:
+			if (has_XR_FB_face_tracking2 && apiName == "xrDestroyFaceTracker2FB") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrDestroyFaceTracker2FB);
+				return XR_SUCCESS;
+			}
+			break;
+		case 79:
+			if (has_XR_FB_display_refresh_rate && apiName == "xrRequestDisplayRefreshRateFB") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrRequestDisplayRefreshRateFB);
+				return XR_SUCCESS;
+			}
+			break;
+		case 80:
+			if (apiName == "xrWaitSwapchainImage") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrWaitSwapchainImage);
+				return XR_SUCCESS;
+			}
+			break;
+		case 81:
+			if (has_XR_KHR_vulkan_enable && apiName == "xrGetVulkanGraphicsDeviceKHR") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetVulkanGraphicsDeviceKHR);
+				return XR_SUCCESS;
+			}
+			break;
+		case 82:
+			if (apiName == "xrCreateInstance") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrCreateInstance);
+				return XR_SUCCESS;
+			}
+			break;
+		case 83:
+			if (apiName == "xrGetActionStatePose") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetActionStatePose);
+				return XR_SUCCESS;
+			}
+			break;
+		case 85:
+			if (has_XR_EXT_hand_tracking && apiName == "xrCreateHandTrackerEXT") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrCreateHandTrackerEXT);
+				return XR_SUCCESS;
+			}
+			break;
+		case 86:
+			if (apiName == "xrRequestExitSession") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrRequestExitSession);
+				return XR_SUCCESS;
+			}
+			break;
+		case 87:
+			if (apiName == "xrAcquireSwapchainImage") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrAcquireSwapchainImage);
+				return XR_SUCCESS;
+			}
+			break;
+		case 88:
+			if (has_XR_KHR_vulkan_enable && apiName == "xrGetVulkanGraphicsRequirementsKHR") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetVulkanGraphicsRequirementsKHR);
+				return XR_SUCCESS;
+			}
+			break;
+		case 91:
+			if (apiName == "xrApplyHapticFeedback") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrApplyHapticFeedback);
+				return XR_SUCCESS;
+			}
+			break;
+		case 93:
+			if (has_XR_FB_body_tracking && apiName == "xrDestroyBodyTrackerFB") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrDestroyBodyTrackerFB);
+				return XR_SUCCESS;
+			}
+			break;
+		case 94:
+			if (apiName == "xrResultToString") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrResultToString);
+				return XR_SUCCESS;
+			}
+			break;
+		case 96:
+			if (has_XR_KHR_visibility_mask && apiName == "xrGetVisibilityMaskKHR") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetVisibilityMaskKHR);
+				return XR_SUCCESS;
+			}
+			break;
+		case 97:
+			if (apiName == "xrGetInstanceProperties") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetInstanceProperties);
+				return XR_SUCCESS;
+			}
+			break;
+		case 98:
+			if (apiName == "xrEnumerateBoundSourcesForAction") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrEnumerateBoundSourcesForAction);
+				return XR_SUCCESS;
+			}
+			break;
+		case 99:
+			if (apiName == "xrGetViewConfigurationProperties") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetViewConfigurationProperties);
+				return XR_SUCCESS;
+			}
+			break;
+		case 101:
+			if (apiName == "xrDestroySwapchain") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrDestroySwapchain);
+				return XR_SUCCESS;
+			}
+			break;
+		case 102:
+			if (has_XR_OCULUS_audio_device_guid && apiName == "xrGetAudioOutputDeviceGuidOculus") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetAudioOutputDeviceGuidOculus);
+				return XR_SUCCESS;
+			}
+			break;
+		case 103:
+			if (has_XR_KHR_opengl_enable && apiName == "xrGetOpenGLGraphicsRequirementsKHR") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetOpenGLGraphicsRequirementsKHR);
+				return XR_SUCCESS;
+			}
+			break;
+		case 105:
+			if (apiName == "xrCreateAction") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrCreateAction);
+				return XR_SUCCESS;
+			}
+			break;
+		case 106:
+			if (apiName == "xrEnumerateViewConfigurations") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrEnumerateViewConfigurations);
+				return XR_SUCCESS;
+			}
+			break;
+		case 107:
+			if (apiName == "xrGetActionStateVector2f") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetActionStateVector2f);
+				return XR_SUCCESS;
+			}
+			break;
+		case 108:
+			if (has_XR_FB_eye_tracking_social && apiName == "xrGetEyeGazesFB") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetEyeGazesFB);
+				return XR_SUCCESS;
+			}
+			break;
+		case 109:
+			if (has_XR_FB_eye_tracking_social && apiName == "xrCreateEyeTrackerFB") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrCreateEyeTrackerFB);
+				return XR_SUCCESS;
+			}
+			break;
+		case 110:
+			if (has_XR_EXT_hand_tracking && apiName == "xrLocateHandJointsEXT") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrLocateHandJointsEXT);
+				return XR_SUCCESS;
+			}
+			break;
+		case 111:
+			if (apiName == "xrEnumerateEnvironmentBlendModes") {
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrEnumerateEnvironmentBlendModes);
+				return XR_SUCCESS;
+			}
+			break;
+		}
+
+		return XR_ERROR_FUNCTION_UNSUPPORTED;
 	}
 
 	// Auto-generated extension registration handler.
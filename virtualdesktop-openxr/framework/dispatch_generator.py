@@ -205,34 +205,58 @@ namespace RUNTIME_NAMESPACE {
         return generated
 
     def genGetInstanceProcAddr(self):
-        generated = '''	XrResult OpenXrApi::xrGetInstanceProcAddr(XrInstance instance, const char* name, PFN_xrVoidFunction* function) {
-		const std::string_view apiName(name);
-
-		if (apiName == "xrGetInstanceProcAddr") {
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetInstanceProcAddr);
-		}
-'''
-
+        # (name, requirements) for every command we resolve.
+        commands = [('xrGetInstanceProcAddr', None)]
         for cur_cmd in self.core_commands:
             if cur_cmd.name not in EXCLUDED_API:
-                generated += f'''		else if (apiName == "{cur_cmd.name}") {{
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::{cur_cmd.name});
-		}}
-'''
-
+                commands.append((cur_cmd.name, None))
         for cur_cmd in self.ext_commands:
             if cur_cmd.name not in EXCLUDED_API:
                 requirements = " && ".join([f"has_{required_ext}" for required_ext in cur_cmd.required_exts])
-                generated += f'''		else if ({requirements} && apiName == "{cur_cmd.name}") {{
-			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::{cur_cmd.name});
+                commands.append((cur_cmd.name, requirements))
+
+        displacements, table_size = makePerfectHash([name for (name, _) in commands])
+        slots = {}
+        for (name, requirements) in commands:
+            displacement = displacements[hashCommandName(name, 0) % len(displacements)]
+            slots[hashCommandName(name, displacement) % table_size] = (name, requirements)
+
+        generated = f'''	namespace {{
+		// FNV-1a, with a seed. Must match hashCommandName() in dispatch_generator.py.
+		constexpr uint32_t hashCommandName(std::string_view name, uint32_t seed) {{
+			uint32_t hash = 2166136261u ^ seed;
+			for (const char c : name) {{
+				hash = (hash ^ (uint8_t)c) * 16777619u;
+			}}
+			return hash;
 		}}
+	}} // namespace
+
+	XrResult OpenXrApi::xrGetInstanceProcAddr(XrInstance instance, const char* name, PFN_xrVoidFunction* function) {{
+		const std::string_view apiName(name);
+
+		// Perfect hash (hash and displace) over the command names, so that only one string comparison is needed.
+		static constexpr uint32_t displacements[{len(displacements)}] = {{{", ".join([str(d) for d in displacements])}}};
+		const uint32_t bucket = hashCommandName(apiName, 0) % {len(displacements)};
+		const uint32_t slot = hashCommandName(apiName, displacements[bucket]) % {table_size};
+
+		switch (slot) {{
 '''
 
-        generated += f'''		else {{
-			return XR_ERROR_FUNCTION_UNSUPPORTED;
-		}}
+        for slot in sorted(slots.keys()):
+            (name, requirements) = slots[slot]
+            condition = f'{requirements} && apiName == "{name}"' if requirements else f'apiName == "{name}"'
+            generated += f'''		case {slot}:
+			if ({condition}) {{
+				*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::{name});
+				return XR_SUCCESS;
+			}}
+			break;
+'''
 
-		return XR_SUCCESS;
+        generated += f'''		}}
+
+		return XR_ERROR_FUNCTION_UNSUPPORTED;
 	}}'''
 
         return generated
@@ -324,6 +348,40 @@ namespace RUNTIME_NAMESPACE {
 
         return generated
 
+def hashCommandName(name, seed):
+    """FNV-1a, with a seed. Must match hashCommandName() in the generated code."""
+    hash = 2166136261 ^ seed
+    for c in name.encode():
+        hash = ((hash ^ c) * 16777619) & 0xffffffff
+    return hash
+
+def makePerfectHash(names):
+    """Build a perfect hash (hash and displace) over the names. Returns the displacement for each bucket, and the
+       table size."""
+    num_buckets = max(1, len(names) // 4)
+    table_size = max(1, (len(names) * 5) // 4)
+
+    buckets = [[] for _ in range(num_buckets)]
+    for name in names:
+        buckets[hashCommandName(name, 0) % num_buckets].append(name)
+
+    # Place the largest buckets first, while the table is mostly empty.
+    displacements = [0] * num_buckets
+    used = set()
+    for index in sorted(range(num_buckets), key=lambda i: len(buckets[i]), reverse=True):
+        if not buckets[index]:
+            continue
+        for displacement in range(1, 1 << 20):
+            slots = [hashCommandName(name, displacement) % table_size for name in buckets[index]]
+            if len(set(slots)) == len(slots) and not used.intersection(slots):
+                displacements[index] = displacement
+                used.update(slots)
+                break
+        else:
+            raise Exception('Could not build a perfect hash')
+
+    return displacements, table_size
+
 def makeREstring(strings, default=None):
     """Turn a list of strings into a regexp string matching exactly those strings."""
     if strings or default is None:
@@ -68,23 +68,20 @@ namespace {
         XrVector3f barycenter{};
         XrPosef accumulatedPose = basePose;
         XrPosef wristPose;
+
+        // We need extra rotations to convert from what SteamVR expects to what OpenXR expects.
+        const XrPosef jointCorrection =
+            Pose::Orientation({(side == xr::Side::Left) ? 0.f : (float)M_PI, (float)-M_PI_2, (float)M_PI});
+        const XrPosef wristCorrection =
+            Pose::Orientation({(float)M_PI, 0.f, (side == xr::Side::Left) ? (float)-M_PI_2 : (float)M_PI_2});
+
         for (uint32_t i = 0; i <= eBone_PinkyFinger4; i++) {
             accumulatedPose = Pose::Multiply(vrPoseToXrPose(bones[i]), accumulatedPose);
 
             // Palm is estimated after this loop.
             if (i != XR_HAND_JOINT_PALM_EXT) {
-                // We need extra rotations to convert from what SteamVR expects to what OpenXR expects.
-                XrPosef correctedPose;
-                if (i != XR_HAND_JOINT_WRIST_EXT) {
-                    correctedPose = Pose::Multiply(
-                        Pose::Orientation({(side == xr::Side::Left) ? 0.f : (float)M_PI, (float)-M_PI_2, (float)M_PI}),
-                        accumulatedPose);
-                } else {
-                    correctedPose = Pose::Multiply(
-                        Pose::Orientation(
-                            {(float)M_PI, 0.f, (side == xr::Side::Left) ? (float)-M_PI_2 : (float)M_PI_2}),
-                        accumulatedPose);
-                }
+                const XrPosef correctedPose = Pose::Multiply(
+                    i != XR_HAND_JOINT_WRIST_EXT ? jointCorrection : wristCorrection, accumulatedPose);
                 joints[i].Pose = xrPoseToBodyTrackingPose(correctedPose);
             }
 
@@ -300,13 +297,19 @@ namespace virtualdesktop_openxr {
         Space& xrBaseSpace = *(Space*)locateInfo->baseSpace;
 
         XrPosef baseSpaceToVirtual = Pose::Identity();
-        const auto flags = locateSpaceToOrigin(xrBaseSpace, locateInfo->time, baseSpaceToVirtual, nullptr, nullptr);
+        XrSpaceVelocity baseSpaceToVirtualVelocity{};
+        const auto flags = locateSpaceToOrigin(xrBaseSpace,
+                                               locateInfo->time,
+                                               baseSpaceToVirtual,
+                                               velocities ? &baseSpaceToVirtualVelocity : nullptr,
+                                               nullptr);
 
         BodyTracking::FingerJointState simulationJointStates[XR_HAND_JOINT_COUNT_EXT];
         BodyTracking::FingerJointState* joints = nullptr;
 
         {
-            std::shared_lock lock(m_bodyStateMutex);
+            BodyTracking::BodyStateV2 bodyState{};
+            const bool hasBodyState = getBodyState(locateInfo->time, bodyState);
 
             locations->isActive = XR_FALSE;
 
@@ -315,18 +318,21 @@ namespace virtualdesktop_openxr {
             }
 
             // Check the hand state.
-            bool needHeightAdjustment = ovr_GetTrackingOriginType(m_ovrSession) == ovrTrackingOrigin_FloorLevel;
-            if (m_bodyState && xrHandTracker.useOpticalTracking &&
-                ((xrHandTracker.side == xr::Side::Left && m_cachedBodyState.LeftHandActive) ||
-                 (xrHandTracker.side == xr::Side::Right && m_cachedBodyState.RightHandActive))) {
-                joints = xrHandTracker.side == xr::Side::Left ? m_cachedBodyState.LeftHandJointStates
-                                                              : m_cachedBodyState.RightHandJointStates;
+            ovrTrackingOrigin originType;
+            float floorHeight;
+            getTrackingOrigin(locateInfo->time, originType, floorHeight);
+            bool needHeightAdjustment = originType == ovrTrackingOrigin_FloorLevel;
+            if (hasBodyState && xrHandTracker.useOpticalTracking &&
+                ((xrHandTracker.side == xr::Side::Left && bodyState.LeftHandActive) ||
+                 (xrHandTracker.side == xr::Side::Right && bodyState.RightHandActive))) {
+                joints = xrHandTracker.side == xr::Side::Left ? bodyState.LeftHandJointStates
+                                                              : bodyState.RightHandJointStates;
 
                 TraceLoggingWrite(g_traceProvider,
                                   "xrLocateHandJointsEXT",
                                   TLArg(xrHandTracker.side == xr::Side::Left ? "Left" : "Right", "Side"),
-                                  TLArg(xrHandTracker.side == xr::Side::Left ? !!m_cachedBodyState.LeftHandActive
-                                                                             : !!m_cachedBodyState.RightHandActive,
+                                  TLArg(xrHandTracker.side == xr::Side::Left ? !!bodyState.LeftHandActive
+                                                                             : !!bodyState.RightHandActive,
                                         "HandActive"),
                                   TLArg(xr::ToString(joints[XR_HAND_JOINT_PALM_EXT].Pose).c_str(), "Palm"),
                                   TLArg(xr::ToString(joints[XR_HAND_JOINT_WRIST_EXT].Pose).c_str(), "Wrist"),
@@ -350,8 +356,8 @@ namespace virtualdesktop_openxr {
                 TraceLoggingWrite(g_traceProvider,
                                   "xrLocateHandJointsEXT",
                                   TLArg(xrHandTracker.side == xr::Side::Left ? "Left" : "Right", "Side"),
-                                  TLArg(!!m_cachedBodyState.LeftHandActive, "LeftHandActive"),
-                                  TLArg(!!m_cachedBodyState.RightHandActive, "RightHandActive"),
+                                  TLArg(!!bodyState.LeftHandActive, "LeftHandActive"),
+                                  TLArg(!!bodyState.RightHandActive, "RightHandActive"),
                                   TLArg(flags2, "ControllerLocationFlags"));
 
                 if (Pose::IsPoseValid(flags2)) {
@@ -411,7 +417,6 @@ namespace virtualdesktop_openxr {
             if (needHeightAdjustment) {
                 // Virtual Desktop queries the joints in local or stage space depending on whether Stage Tracking is
                 // enabled. We need to offset to the virtual space.
-                const float floorHeight = ovr_GetFloat(m_ovrSession, OVR_KEY_EYE_HEIGHT, OVR_DEFAULT_EYE_HEIGHT);
                 TraceLoggingWrite(g_traceProvider, "OVR_GetConfig", TLArg(floorHeight, "EyeHeight"));
                 jointsToVirtual =
                     (std::abs(floorHeight) >= FLT_EPSILON) ? Pose::Translation({0, floorHeight, 0}) : Pose::Identity();
@@ -419,28 +424,40 @@ namespace virtualdesktop_openxr {
             const XrPosef basePose = Pose::Multiply(jointsToVirtual, Pose::Invert(baseSpaceToVirtual));
 
             for (uint32_t i = 0; i < locations->jointCount; i++) {
-                const XrPosef poseOfJoint = Pose::MakePose(
-                    XrQuaternionf{joints[i].Pose.orientation.x,
-                                  joints[i].Pose.orientation.y,
-                                  joints[i].Pose.orientation.z,
-                                  joints[i].Pose.orientation.w},
-                    XrVector3f{joints[i].Pose.position.x, joints[i].Pose.position.y, joints[i].Pose.position.z});
-
-                locations->jointLocations[i].pose = Pose::Multiply(poseOfJoint, basePose);
                 locations->jointLocations[i].locationFlags =
                     (XR_SPACE_LOCATION_ORIENTATION_VALID_BIT | XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT |
                      XR_SPACE_LOCATION_POSITION_VALID_BIT | XR_SPACE_LOCATION_POSITION_TRACKED_BIT);
+            }
+            TransformJointPoses(basePose, joints, locations->jointLocations, locations->jointCount);
 
+            for (uint32_t i = 0; i < locations->jointCount; i++) {
                 // Forward the rest of the data as-is from the memory mapped file.
                 locations->jointLocations[i].radius = joints[i].Radius;
 
                 if (velocities) {
-                    velocities->jointVelocities[i].angularVelocity = {
+                    // The joints velocities are in the same space as their poses. Make them relative to the base space
+                    // (jointsToVirtual being a fixed translation does not affect them).
+                    XrSpaceVelocity jointVelocity{};
+                    jointVelocity.angularVelocity = {
                         joints[i].AngularVelocity.x, joints[i].AngularVelocity.y, joints[i].AngularVelocity.z};
-                    velocities->jointVelocities[i].linearVelocity = {
+                    jointVelocity.linearVelocity = {
                         joints[i].LinearVelocity.x, joints[i].LinearVelocity.y, joints[i].LinearVelocity.z};
+                    const XrPosef jointToVirtual = Pose::Multiply(
+                        Pose::MakePose(XrQuaternionf{joints[i].Pose.orientation.x,
+                                                     joints[i].Pose.orientation.y,
+                                                     joints[i].Pose.orientation.z,
+                                                     joints[i].Pose.orientation.w},
+                                       XrVector3f{joints[i].Pose.position.x,
+                                                  joints[i].Pose.position.y,
+                                                  joints[i].Pose.position.z}),
+                        jointsToVirtual);
+                    MakeVelocityRelative(jointToVirtual, jointVelocity, baseSpaceToVirtual, baseSpaceToVirtualVelocity);
+
+                    velocities->jointVelocities[i].angularVelocity = jointVelocity.angularVelocity;
+                    velocities->jointVelocities[i].linearVelocity = jointVelocity.linearVelocity;
                     velocities->jointVelocities[i].velocityFlags =
-                        XR_SPACE_VELOCITY_ANGULAR_VALID_BIT | XR_SPACE_VELOCITY_LINEAR_VALID_BIT;
+                        baseSpaceToVirtualVelocity.velocityFlags &
+                        (XR_SPACE_VELOCITY_ANGULAR_VALID_BIT | XR_SPACE_VELOCITY_LINEAR_VALID_BIT);
 
                     TraceLoggingWrite(
                         g_traceProvider,
@@ -463,9 +480,8 @@ namespace virtualdesktop_openxr {
             }
 
             if (has_XR_FB_hand_tracking_aim && aimState) {
-                const BodyTracking::HandTrackingAimState& aim = xrHandTracker.side == xr::Side::Left
-                                                                    ? m_cachedBodyState.LeftAimState
-                                                                    : m_cachedBodyState.RightAimState;
+                const BodyTracking::HandTrackingAimState& aim =
+                    xrHandTracker.side == xr::Side::Left ? bodyState.LeftAimState : bodyState.RightAimState;
 
                 aimState->status = aim.AimStatus;
                 aimState->aimPose = Pose::Multiply(
@@ -496,19 +512,18 @@ namespace virtualdesktop_openxr {
     }
 
     // Detect hand gestures and convert them into controller inputs.
-    void OpenXrRuntime::processHandGestures(uint32_t side) {
-        std::shared_lock lock(m_bodyStateMutex);
-
-        if (m_bodyState &&
-            ((side == xr::Side::Left && m_cachedBodyState.LeftHandActive) || m_cachedBodyState.RightHandActive)) {
+    void OpenXrRuntime::processHandGestures(uint32_t side, ovrInputState& inputState) const {
+        BodyTracking::BodyStateV2 bodyState{};
+        if (getLatestBodyState(bodyState) &&
+            ((side == xr::Side::Left && bodyState.LeftHandActive) || bodyState.RightHandActive)) {
             const BodyTracking::FingerJointState* joints =
-                side == xr::Side::Left ? m_cachedBodyState.LeftHandJointStates : m_cachedBodyState.RightHandJointStates;
+                side == xr::Side::Left ? bodyState.LeftHandJointStates : bodyState.RightHandJointStates;
             const bool otherJointsValid =
-                side == xr::Side::Left ? m_cachedBodyState.LeftHandActive : m_cachedBodyState.RightHandActive;
+                side == xr::Side::Left ? bodyState.LeftHandActive : bodyState.RightHandActive;
             const BodyTracking::FingerJointState* otherJoints =
-                side == xr::Side::Left ? m_cachedBodyState.RightHandJointStates : m_cachedBodyState.LeftHandJointStates;
+                side == xr::Side::Left ? bodyState.RightHandJointStates : bodyState.LeftHandJointStates;
             const BodyTracking::HandTrackingAimState& aimState =
-                side == xr::Side::Left ? m_cachedBodyState.LeftAimState : m_cachedBodyState.RightAimState;
+                side == xr::Side::Left ? bodyState.LeftAimState : bodyState.RightAimState;
 
             TraceLoggingWrite(
                 g_traceProvider,
@@ -537,15 +552,14 @@ namespace virtualdesktop_openxr {
             static constexpr float Threshold = 0.9f;
 
             // Pinch.
-            m_cachedInputState.IndexTrigger[side] =
-                std::max(m_cachedInputState.IndexTrigger[side], aimState.PinchStrengthIndex);
+            inputState.IndexTrigger[side] = std::max(inputState.IndexTrigger[side], aimState.PinchStrengthIndex);
 
             if (otherJointsValid) {
                 // Y.
                 if (side == xr::Side::Left) {
                     if (jointActionValue(joints[XR_HAND_JOINT_PALM_EXT], otherJoints[XR_HAND_JOINT_INDEX_TIP_EXT]) >
                         Threshold) {
-                        m_cachedInputState.Buttons |= ovrButton_Y;
+                        inputState.Buttons |= ovrButton_Y;
                     }
                 }
 
@@ -553,7 +567,7 @@ namespace virtualdesktop_openxr {
                 if (side == xr::Side::Right) {
                     if (jointActionValue(joints[XR_HAND_JOINT_PALM_EXT], otherJoints[XR_HAND_JOINT_INDEX_TIP_EXT]) >
                         Threshold) {
-                        m_cachedInputState.Buttons |= ovrButton_B;
+                        inputState.Buttons |= ovrButton_B;
                     }
                 }
             }
@@ -562,30 +576,27 @@ namespace virtualdesktop_openxr {
                 g_traceProvider,
                 "HandGestures",
                 TLArg(side == 0 ? "Left" : "Right", "Side"),
-                TLArg(m_cachedInputState.Buttons & (side == 0 ? ovrButton_LMask : ovrButton_RMask), "Buttons"),
-                TLArg(m_cachedInputState.IndexTrigger[side], "IndexTrigger"),
-                TLArg(m_cachedInputState.HandTrigger[side], "HandTrigger"),
-                TLArg(
-                    fmt::format("{}, {}", m_cachedInputState.Thumbstick[side].x, m_cachedInputState.Thumbstick[side].y)
-                        .c_str(),
-                    "Joystick"));
+                TLArg(inputState.Buttons & (side == 0 ? ovrButton_LMask : ovrButton_RMask), "Buttons"),
+                TLArg(inputState.IndexTrigger[side], "IndexTrigger"),
+                TLArg(inputState.HandTrigger[side], "HandTrigger"),
+                TLArg(fmt::format("{}, {}", inputState.Thumbstick[side].x, inputState.Thumbstick[side].y).c_str(),
+                      "Joystick"));
         } else {
             TraceLoggingWrite(g_traceProvider,
                               "HandGestures",
                               TLArg(side == xr::Side::Left ? "Left" : "Right", "Side"),
-                              TLArg(!!m_cachedBodyState.LeftHandActive, "LeftHandActive"),
-                              TLArg(!!m_cachedBodyState.RightHandActive, "RightHandActive"));
+                              TLArg(!!bodyState.LeftHandActive, "LeftHandActive"),
+                              TLArg(!!bodyState.RightHandActive, "RightHandActive"));
         }
     }
 
     // Get the pinch pose (replacing aim pose).
-    bool OpenXrRuntime::getPinchPose(int side, const XrPosef& controllerPose, XrPosef& pose) const {
-        std::shared_lock lock(m_bodyStateMutex);
-
-        if (m_bodyState &&
-            ((side == xr::Side::Left && m_cachedBodyState.LeftHandActive) || m_cachedBodyState.RightHandActive)) {
+    bool OpenXrRuntime::getPinchPose(int side, XrTime time, const XrPosef& controllerPose, XrPosef& pose) const {
+        BodyTracking::BodyStateV2 bodyState{};
+        if (getLatestBodyState(bodyState) &&
+            ((side == xr::Side::Left && bodyState.LeftHandActive) || bodyState.RightHandActive)) {
             const BodyTracking::HandTrackingAimState& aimState =
-                side == xr::Side::Left ? m_cachedBodyState.LeftAimState : m_cachedBodyState.RightAimState;
+                side == xr::Side::Left ? bodyState.LeftAimState : bodyState.RightAimState;
             const bool isAimValid = aimState.AimStatus & XR_HAND_TRACKING_AIM_VALID_BIT_FB;
 
             TraceLoggingWrite(g_traceProvider,
@@ -598,8 +609,10 @@ namespace virtualdesktop_openxr {
 
             // Virtual Desktop queries the joints in local or stage space depending on whether Stage Tracking is
             // enabled. We need to offset to the virtual space.
-            assert(ovr_GetTrackingOriginType(m_ovrSession) == ovrTrackingOrigin_FloorLevel);
-            const float floorHeight = ovr_GetFloat(m_ovrSession, OVR_KEY_EYE_HEIGHT, OVR_DEFAULT_EYE_HEIGHT);
+            ovrTrackingOrigin originType;
+            float floorHeight;
+            getTrackingOrigin(time, originType, floorHeight);
+            assert(originType == ovrTrackingOrigin_FloorLevel);
             TraceLoggingWrite(g_traceProvider, "OVR_GetConfig", TLArg(floorHeight, "EyeHeight"));
             const XrPosef baseToVirtual =
                 (std::abs(floorHeight) >= FLT_EPSILON) ? Pose::Translation({0, floorHeight, 0}) : Pose::Identity();
@@ -618,8 +631,8 @@ namespace virtualdesktop_openxr {
             TraceLoggingWrite(g_traceProvider,
                               "PinchPose",
                               TLArg(side == xr::Side::Left ? "Left" : "Right", "Side"),
-                              TLArg(!!m_cachedBodyState.LeftHandActive, "LeftHandActive"),
-                              TLArg(!!m_cachedBodyState.RightHandActive, "RightHandActive"));
+                              TLArg(!!bodyState.LeftHandActive, "LeftHandActive"),
+                              TLArg(!!bodyState.RightHandActive, "RightHandActive"));
             return false;
         }
     }
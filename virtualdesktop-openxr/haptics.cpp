@@ -0,0 +1,207 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "log.h"
+#include "runtime.h"
+#include "utils.h"
+
+// Implements the scheduling of controller vibrations. The LibOVR calls are made from a dedicated thread, only when the
+// vibration changes, when it must be re-asserted, or when it expires.
+
+namespace {
+
+    // LibOVR stops a vibration on its own after about 2.5s. Re-assert it well before that.
+    constexpr auto k_vibrationRefreshPeriod = std::chrono::seconds(1);
+
+    // Avoid overflowing the clock with very long (eg: INT64_MAX) durations.
+    constexpr auto k_maxVibrationDuration = std::chrono::hours(1);
+
+} // namespace
+
+namespace virtualdesktop_openxr {
+
+    using namespace virtualdesktop_openxr::log;
+    using namespace virtualdesktop_openxr::utils;
+
+    void OpenXrRuntime::startHapticsThread() {
+        for (uint32_t side = 0; side < xr::Side::Count; side++) {
+            m_currentVibration[side] = {};
+        }
+
+        *m_hapticsWakeEvent.put() = CreateEventW(nullptr, false, false, nullptr);
+        // A high-resolution timer gives us ~1ms accuracy on the deadlines, without raising the system timer resolution.
+        // It is not supported before Windows 10 1803.
+        *m_hapticsTimer.put() =
+            CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+        if (!m_hapticsTimer) {
+            *m_hapticsTimer.put() = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+        }
+        if (!m_hapticsTimer) {
+            // The haptics thread falls back to wait timeouts.
+            ErrorLog("Failed to create haptics timer: %d\n", GetLastError());
+        }
+
+        m_terminateHapticsThread = false;
+        m_hapticsThread = std::thread([&]() { hapticsThread(); });
+    }
+
+    void OpenXrRuntime::stopHapticsThread() {
+        if (!m_hapticsThread.joinable()) {
+            return;
+        }
+
+        {
+            std::unique_lock lock(m_hapticsMutex);
+            m_terminateHapticsThread = true;
+        }
+        SetEvent(m_hapticsWakeEvent.get());
+        m_hapticsThread.join();
+        m_hapticsThread = {};
+
+        m_hapticsWakeEvent.reset();
+        m_hapticsTimer.reset();
+    }
+
+    // Replace the vibration for a controller. An amplitude of 0 stops the vibration.
+    void OpenXrRuntime::scheduleVibration(int side, float frequency, float amplitude, XrDuration duration) {
+        {
+            std::unique_lock lock(m_hapticsMutex);
+
+            Haptic& haptic = m_currentVibration[side];
+            haptic.frequency = frequency;
+            haptic.amplitude = amplitude;
+            haptic.deadline = std::chrono::high_resolution_clock::now() +
+                              std::min<std::chrono::high_resolution_clock::duration>(
+                                  std::chrono::nanoseconds(std::max(duration, (XrDuration)0)), k_maxVibrationDuration);
+            haptic.isDirty = true;
+        }
+
+        TraceLoggingWrite(g_traceProvider,
+                          "ScheduleVibration",
+                          TLArg(side, "Side"),
+                          TLArg(frequency, "Frequency"),
+                          TLArg(amplitude, "Amplitude"),
+                          TLArg(duration, "Duration"));
+        SetEvent(m_hapticsWakeEvent.get());
+    }
+
+    void OpenXrRuntime::hapticsThread() {
+        TraceLocalActivity(local);
+        TraceLoggingWriteStart(local, "HapticsThread");
+
+        SetThreadPriority(GetCurrentThread(), getSetting("haptics_thread_priority").value_or(THREAD_PRIORITY_HIGHEST));
+
+        const auto setControllerVibration = [&](int side, float frequency, float amplitude) {
+            const auto result = ovr_SetControllerVibration(
+                m_ovrSession, side == 0 ? ovrControllerType_LTouch : ovrControllerType_RTouch, frequency, amplitude);
+            TraceLoggingWrite(g_traceProvider,
+                              "OVR_SetControllerVibration",
+                              TLArg(side == 0 ? "Left" : "Right", "Side"),
+                              TLArg(frequency, "Frequency"),
+                              TLArg(amplitude, "Amplitude"),
+                              TLArg(result, "Result"));
+        };
+
+        bool isVibrating[xr::Side::Count]{false, false};
+        while (true) {
+            std::optional<std::chrono::high_resolution_clock::time_point> nextWakeup;
+
+            // The LibOVR calls are made outside of the lock, to never block xrApplyHapticFeedback().
+            struct {
+                float frequency;
+                float amplitude;
+            } pendingVibration[xr::Side::Count];
+            bool hasPendingVibration[xr::Side::Count]{false, false};
+            {
+                std::unique_lock lock(m_hapticsMutex);
+
+                if (m_terminateHapticsThread) {
+                    break;
+                }
+
+                const auto now = std::chrono::high_resolution_clock::now();
+                for (uint32_t side = 0; side < xr::Side::Count; side++) {
+                    Haptic& haptic = m_currentVibration[side];
+
+                    if (haptic.amplitude > 0 && now >= haptic.deadline) {
+                        haptic.amplitude = haptic.frequency = 0.f;
+                        haptic.isDirty = true;
+                    }
+
+                    const bool needRefresh =
+                        haptic.amplitude > 0 && now - haptic.lastSubmitTime >= k_vibrationRefreshPeriod;
+                    if (haptic.isDirty || needRefresh) {
+                        // Do not bother LibOVR with stopping an idle controller.
+                        if (haptic.amplitude > 0 || isVibrating[side]) {
+                            pendingVibration[side] = {haptic.frequency, haptic.amplitude};
+                            hasPendingVibration[side] = true;
+                        }
+                        isVibrating[side] = haptic.amplitude > 0;
+                        haptic.lastSubmitTime = now;
+                        haptic.isDirty = false;
+                    }
+
+                    if (haptic.amplitude > 0) {
+                        const auto wakeup = std::min(haptic.deadline, haptic.lastSubmitTime + k_vibrationRefreshPeriod);
+                        nextWakeup = std::min(nextWakeup.value_or(wakeup), wakeup);
+                    }
+                }
+            }
+
+            for (uint32_t side = 0; side < xr::Side::Count; side++) {
+                if (hasPendingVibration[side]) {
+                    setControllerVibration(side, pendingVibration[side].frequency, pendingVibration[side].amplitude);
+                }
+            }
+
+            HANDLE handles[] = {m_hapticsWakeEvent.get(), m_hapticsTimer.get()};
+            DWORD handleCount = 1;
+            DWORD timeout = INFINITE;
+            if (nextWakeup) {
+                // Negative values are relative times, in 100ns units.
+                const auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    nextWakeup.value() - std::chrono::high_resolution_clock::now());
+                LARGE_INTEGER dueTime;
+                dueTime.QuadPart = -std::max(remaining.count() / 100, 1ll);
+                if (m_hapticsTimer && SetWaitableTimer(m_hapticsTimer.get(), &dueTime, 0, nullptr, nullptr, false)) {
+                    handleCount = 2;
+                } else {
+                    // Round up, so we do not wake up just before the deadline.
+                    timeout = (DWORD)std::max((remaining.count() + 999999) / 1000000, 1ll);
+                }
+            }
+            WaitForMultipleObjects(handleCount, handles, false, timeout);
+        }
+
+        // Never leave the controllers vibrating.
+        for (uint32_t side = 0; side < xr::Side::Count; side++) {
+            if (isVibrating[side]) {
+                setControllerVibration(side, 0.f, 0.f);
+            }
+        }
+
+        TraceLoggingWriteStop(local, "HapticsThread");
+    }
+
+} // namespace virtualdesktop_openxr
@@ -54,6 +54,9 @@ namespace virtualdesktop_openxr {
             xr::ToString(XR_MAKE_VERSION(RuntimeVersionMajor, RuntimeVersionMinor, RuntimeVersionPatch));
         TraceLoggingWrite(g_traceProvider, "VirtualDesktopOpenXR", TLArg(runtimeVersion.c_str(), "Version"));
 
+        // Keep the log I/O off the application threads.
+        m_logWriterThread = StartLogWriter();
+
         m_useApplicationDeviceForSubmission = getSetting("quirk_use_application_device_for_submission").value_or(false);
 
         // Latch the disabled trackers now.
@@ -106,6 +109,12 @@ namespace virtualdesktop_openxr {
             ovr_Destroy(m_ovrSession);
         }
         ovr_Shutdown();
+
+        StopLogWriter(m_logWriterThread);
+    }
+
+    void OpenXrRuntime::detachLogWriter() {
+        StopLogWriter(m_logWriterThread, false /* wait */);
     }
 
     // https://www.khronos.org/registry/OpenXR/specs/1.0/html/xrspec.html#xrGetInstanceProcAddr
@@ -299,6 +308,8 @@ namespace virtualdesktop_openxr {
                                        getSetting("quirk_allow_static_swapchains_reuse").value_or(false);
 
         m_forceSlowpathSwapchains = getSetting("quirk_force_slowpath_swapchains").value_or(false);
+        m_useSmallAlphaCorrectionGroups = getSetting("alpha_correction_small_groups").value_or(false);
+        m_viewCache.setCapacity(std::max(getSetting("view_cache_capacity").value_or(256), 1));
 
         // Do this late, since it might rely on extensions being registered.
         initializeRemappingTables();
@@ -536,6 +547,9 @@ namespace virtualdesktop_openxr {
         m_extensionsTable.push_back( // Palm pose.
             {XR_EXT_PALM_POSE_EXTENSION_NAME, XR_EXT_palm_pose_SPEC_VERSION});
 
+        m_extensionsTable.push_back( // Action set priority override.
+            {XR_EXT_ACTIVE_ACTION_SET_PRIORITY_EXTENSION_NAME, XR_EXT_active_action_set_priority_SPEC_VERSION});
+
         m_extensionsTable.push_back( // Audio GUID.
             {XR_OCULUS_AUDIO_DEVICE_GUID_EXTENSION_NAME, XR_OCULUS_audio_device_guid_SPEC_VERSION});
 
@@ -692,6 +706,14 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
         break;
 
     case DLL_PROCESS_DETACH:
+        // The application did not destroy its instance. We cannot join the log writer thread under the loader lock,
+        // and upon process termination (lpReserved != nullptr) it is already gone. Let it go, so that the destruction
+        // of the instance does not wait for it either.
+        if (virtualdesktop_openxr::g_instance) {
+            virtualdesktop_openxr::g_instance->detachLogWriter();
+        }
+        // The log writer thread may have been holding the lock when terminated. Do not wait on it.
+        virtualdesktop_openxr::log::FlushLog(false);
 #ifdef _WIN64
         DetourDllDetach("Kernel32", "OpenEventW", hooked_OpenEventW, original_OpenEventW);
 #endif
@@ -0,0 +1,58 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "pch.h"
+
+namespace virtualdesktop_openxr::utils {
+
+    // Transform the poses of a batch of joints by a common base pose, ie: locations[i].pose = joints[i].Pose * base.
+    // The base transform is decomposed once for the whole batch, which leaves one quaternion product and one affine
+    // transform per joint. DirectXMath compiles these to SSE or NEON, or to scalar code with _XM_NO_INTRINSICS_.
+    // Joints whose location flags do not report a valid pose are left untouched.
+    template <typename Joint, typename JointLocation>
+    void TransformJointPoses(const XrPosef& base, const Joint* joints, JointLocation* locations, uint32_t count) {
+        using namespace DirectX;
+
+        static_assert(sizeof(joints->Pose.orientation) == sizeof(XMFLOAT4));
+        static_assert(sizeof(joints->Pose.position) == sizeof(XMFLOAT3));
+
+        const XMVECTOR baseOrientation = xr::math::LoadXrQuaternion(base.orientation);
+        XMMATRIX baseTransform = XMMatrixRotationQuaternion(baseOrientation);
+        baseTransform.r[3] = XMVectorSetW(xr::math::LoadXrVector3(base.position), 1.f);
+
+        for (uint32_t i = 0; i < count; i++) {
+            if (!xr::math::Pose::IsPoseValid(locations[i].locationFlags)) {
+                continue;
+            }
+
+            const XMVECTOR orientation = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&joints[i].Pose.orientation));
+            const XMVECTOR position = XMLoadFloat3(reinterpret_cast<const XMFLOAT3*>(&joints[i].Pose.position));
+
+            xr::math::StoreXrQuaternion(&locations[i].pose.orientation,
+                                        XMQuaternionMultiply(orientation, baseOrientation));
+            xr::math::StoreXrVector3(&locations[i].pose.position, XMVector3Transform(position, baseTransform));
+        }
+    }
+
+} // namespace virtualdesktop_openxr::utils
@@ -45,21 +45,189 @@ namespace virtualdesktop_openxr::log {
 
     namespace {
 
+        constexpr size_t k_maxRecordLength = 1024;
+        constexpr uint32_t k_numRecords = 256;
+
+        // A bounded multi-producer ring of formatted log lines. Each record carries a sequence number telling whether
+        // it is free for the producer at that position, or ready for the consumer at that position.
+        struct LogRing {
+            struct Record {
+                std::atomic<uint32_t> sequence;
+                char text[k_maxRecordLength];
+            };
+
+            LogRing() {
+                for (uint32_t i = 0; i < k_numRecords; i++) {
+                    records[i].sequence.store(i, std::memory_order_relaxed);
+                }
+            }
+
+            // Returns false when the ring is full.
+            bool push(const char* text) {
+                uint32_t position = enqueuePosition.load(std::memory_order_relaxed);
+                while (true) {
+                    Record& record = records[position % k_numRecords];
+                    const int32_t diff = (int32_t)(record.sequence.load(std::memory_order_acquire) - position);
+                    if (diff == 0) {
+                        if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                            strcpy_s(record.text, text);
+                            record.sequence.store(position + 1, std::memory_order_release);
+                            return true;
+                        }
+                    } else if (diff < 0) {
+                        return false;
+                    } else {
+                        position = enqueuePosition.load(std::memory_order_relaxed);
+                    }
+                }
+            }
+
+            // Must be called with consumerMutex held.
+            template <typename Consumer>
+            size_t drain(Consumer&& consumer) {
+                size_t count = 0;
+                while (true) {
+                    Record& record = records[dequeuePosition % k_numRecords];
+                    if (record.sequence.load(std::memory_order_acquire) != dequeuePosition + 1) {
+                        break;
+                    }
+                    consumer(record.text);
+                    record.sequence.store(dequeuePosition + k_numRecords, std::memory_order_release);
+                    dequeuePosition++;
+                    count++;
+                }
+                return count;
+            }
+
+            Record records[k_numRecords];
+            std::atomic<uint32_t> enqueuePosition{0};
+            std::mutex consumerMutex;
+            uint32_t dequeuePosition{0};
+            std::atomic<uint32_t> droppedRecords{0};
+        };
+
+        LogRing g_logRing;
+        std::atomic<bool> g_isLogWriterRunning{false};
+        HMODULE g_logWriterModule = nullptr;
+        std::atomic<bool> g_isLogWriterDetached{false};
+
+        // Write out all the pending records. Must be called with consumerMutex held.
+        void DrainLogRing() {
+            const size_t count = g_logRing.drain([](const char* text) {
+                OutputDebugStringA(text);
+                if (logStream.is_open()) {
+                    logStream << text;
+                }
+            });
+
+            const uint32_t dropped = g_logRing.droppedRecords.exchange(0, std::memory_order_relaxed);
+            if (dropped) {
+                char buf[128];
+                sprintf_s(buf, "%u log messages were dropped\n", dropped);
+                OutputDebugStringA(buf);
+                if (logStream.is_open()) {
+                    logStream << buf;
+                }
+            }
+
+            if ((count || dropped) && logStream.is_open()) {
+                logStream.flush();
+            }
+        }
+
+        void LogWriterThread() {
+            while (g_isLogWriterRunning.load(std::memory_order_acquire)) {
+                uint32_t position = g_logRing.enqueuePosition.load(std::memory_order_acquire);
+                {
+                    std::unique_lock lock(g_logRing.consumerMutex);
+                    DrainLogRing();
+                }
+
+                // Wait for new records. The timeout also covers records that were in-flight during the drain.
+                WaitOnAddress(&g_logRing.enqueuePosition, &position, sizeof(position), 100);
+            }
+
+            std::unique_lock lock(g_logRing.consumerMutex);
+            DrainLogRing();
+        }
+
         // Utility logging function.
         void InternalLog(const char* fmt, va_list va) {
             const std::time_t now = std::time(nullptr);
 
-            char buf[1024];
+            char buf[k_maxRecordLength];
             size_t offset = std::strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S %z: ", std::localtime(&now));
             vsnprintf_s(buf + offset, sizeof(buf) - offset, _TRUNCATE, fmt, va);
-            OutputDebugStringA(buf);
-            if (logStream.is_open()) {
-                logStream << buf;
-                logStream.flush();
+
+            if (g_isLogWriterRunning.load(std::memory_order_acquire)) {
+                // The writer thread does the I/O. We never block here: if the writer cannot keep up, we drop lines.
+                if (g_logRing.push(buf)) {
+                    WakeByAddressSingle(&g_logRing.enqueuePosition);
+                } else {
+                    g_logRing.droppedRecords.fetch_add(1, std::memory_order_relaxed);
+                }
+            } else {
+                // A detached writer might have been terminated while holding the lock.
+                std::unique_lock lock(g_logRing.consumerMutex, std::defer_lock);
+                if (!g_isLogWriterDetached.load(std::memory_order_relaxed)) {
+                    lock.lock();
+                    DrainLogRing();
+                } else if (lock.try_lock()) {
+                    DrainLogRing();
+                }
+                OutputDebugStringA(buf);
+                if (logStream.is_open()) {
+                    logStream << buf;
+                    logStream.flush();
+                }
             }
         }
     } // namespace
 
+    std::thread StartLogWriter() {
+        if (g_isLogWriterRunning.exchange(true)) {
+            return {};
+        }
+
+        // The thread runs code from this module, which must not be unloaded underneath it.
+        GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS, (LPCWSTR)&LogWriterThread, &g_logWriterModule);
+
+        return std::thread([] { LogWriterThread(); });
+    }
+
+    void StopLogWriter(std::thread& writer, bool wait) {
+        if (!g_isLogWriterRunning.exchange(false)) {
+            return;
+        }
+        WakeByAddressAll(&g_logRing.enqueuePosition);
+
+        if (!writer.joinable()) {
+            return;
+        }
+        if (!wait) {
+            // Leak the thread and the module reference.
+            g_isLogWriterDetached.store(true, std::memory_order_relaxed);
+            writer.detach();
+            return;
+        }
+
+        writer.join();
+        if (g_logWriterModule) {
+            FreeLibrary(g_logWriterModule);
+            g_logWriterModule = nullptr;
+        }
+    }
+
+    void FlushLog(bool wait) {
+        std::unique_lock lock(g_logRing.consumerMutex, std::defer_lock);
+        if (wait) {
+            lock.lock();
+        } else if (!lock.try_lock()) {
+            return;
+        }
+        DrainLogRing();
+    }
+
     void Log(const char* fmt, ...) {
         va_list va;
         va_start(va, fmt);
@@ -76,6 +244,9 @@ namespace virtualdesktop_openxr::log {
             if (g_globalErrorCount == k_maxLoggedErrors) {
                 Log("Maximum number of errors logged. Going silent.\n");
             }
+
+            // Errors often precede a crash, do not leave them sitting in the ring.
+            FlushLog();
         }
     }
 
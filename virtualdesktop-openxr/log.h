@@ -49,9 +49,20 @@ namespace virtualdesktop_openxr::log {
     // Debug logging function. Can make things very slow (only enabled on Debug builds).
     void DebugLog(const char* fmt, ...);
 
-    // Error logging function. Goes silent after too many errors.
+    // Error logging function. Goes silent after too many errors. Errors are written out before returning.
     void ErrorLog(const char* fmt, ...);
 
+    // Move the log I/O to a background thread, owned by the caller. The module stays loaded until the writer is
+    // stopped. Before StartLogWriter() and after StopLogWriter(), logging is synchronous.
+    std::thread StartLogWriter();
+
+    // Make the writer thread exit. When not waiting (eg: under the loader lock), the thread is detached instead of
+    // joined, and it keeps the module loaded.
+    void StopLogWriter(std::thread& writer, bool wait = true);
+
+    // Write out all the pending log lines. When not waiting, give up if the writer thread is busy.
+    void FlushLog(bool wait = true);
+
 #define OnceLog(...)                                                                                                   \
     {                                                                                                                  \
         static bool logged = false;                                                                                    \
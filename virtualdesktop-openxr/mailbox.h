@@ -0,0 +1,146 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "pch.h"
+
+namespace virtualdesktop_openxr::utils {
+
+    // A single-producer/single-consumer handoff of fixed-size arrays, without locks nor allocations.
+    // The producer fills the back slot and publishes it by swapping it with the middle slot. The consumer takes the
+    // middle slot by swapping it with its front slot. Blocking waits use WaitOnAddress().
+    // In addition, the consumer tells the producer when it is idle (ready for the next publication).
+    template <typename T, size_t Capacity>
+    class TripleBufferMailbox {
+      public:
+        struct Slot {
+            T items[Capacity];
+            uint32_t count{0};
+        };
+
+        TripleBufferMailbox() {
+            reset();
+        }
+
+        // Must not be called while either the producer or the consumer are active. The consumer is not idle until it
+        // calls markIdle() for the first time.
+        void reset() {
+            m_front = 0;
+            m_middle.store(1, std::memory_order_relaxed);
+            m_back = 2;
+            m_isIdle.store(0, std::memory_order_release);
+        }
+
+        // Producer: the slot to fill before calling publish().
+        Slot& back() {
+            return m_slots[m_back];
+        }
+
+        // Producer: hand off the back slot to the consumer.
+        void publish() {
+            m_isIdle.store(0, std::memory_order_relaxed);
+            m_back = swapMiddle(m_back | k_freshBit) & k_indexMask;
+            WakeByAddressSingle(&m_middle);
+        }
+
+        // Producer: wait for the consumer to be idle, optionally until a deadline. Returns false upon timeout.
+        template <typename TimePoint = std::chrono::high_resolution_clock::time_point>
+        bool waitForIdle(std::optional<TimePoint> deadline = {}) {
+            while (true) {
+                uint32_t isIdle = m_isIdle.load(std::memory_order_acquire);
+                if (isIdle) {
+                    return true;
+                }
+
+                DWORD timeout = INFINITE;
+                if (deadline) {
+                    const auto now = TimePoint::clock::now();
+                    if (now >= deadline.value()) {
+                        return false;
+                    }
+
+                    // WaitOnAddress() only has millisecond granularity. Yield for the remainder.
+                    timeout = (DWORD)std::chrono::duration_cast<std::chrono::milliseconds>(deadline.value() - now)
+                                  .count();
+                    if (!timeout) {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                }
+
+                WaitOnAddress(&m_isIdle, &isIdle, sizeof(isIdle), timeout);
+            }
+        }
+
+        // Consumer: signal that we are ready for the next publication.
+        void markIdle() {
+            m_isIdle.store(1, std::memory_order_release);
+            WakeByAddressAll(&m_isIdle);
+        }
+
+        // Consumer: wait for the next publication. Returns nullptr when the mailbox is terminated.
+        Slot* acquire() {
+            while (true) {
+                uint32_t middle = m_middle.load(std::memory_order_acquire);
+                if (middle & k_terminateBit) {
+                    return nullptr;
+                }
+                if (middle & k_freshBit) {
+                    break;
+                }
+
+                WaitOnAddress(&m_middle, &middle, sizeof(middle), INFINITE);
+            }
+
+            m_front = swapMiddle(m_front) & k_indexMask;
+            return &m_slots[m_front];
+        }
+
+        // Unblock the consumer and make it exit.
+        void terminate() {
+            m_middle.fetch_or(k_terminateBit, std::memory_order_release);
+            WakeByAddressAll(&m_middle);
+        }
+
+      private:
+        static constexpr uint32_t k_indexMask = 0x3;
+        static constexpr uint32_t k_freshBit = 0x4;
+        static constexpr uint32_t k_terminateBit = 0x8;
+
+        // Swap the middle slot, preserving a concurrent terminate() request. Returns the previous value.
+        uint32_t swapMiddle(uint32_t value) {
+            uint32_t middle = m_middle.load(std::memory_order_relaxed);
+            while (!m_middle.compare_exchange_weak(
+                middle, value | (middle & k_terminateBit), std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            }
+            return middle;
+        }
+
+        Slot m_slots[3];
+        uint32_t m_front;
+        uint32_t m_back;
+        std::atomic<uint32_t> m_middle;
+        std::atomic<uint32_t> m_isIdle;
+    };
+
+} // namespace virtualdesktop_openxr::utils
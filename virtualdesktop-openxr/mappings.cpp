@@ -47,7 +47,7 @@ namespace virtualdesktop_openxr {
                                                                  "/interaction_profiles/oculus/touch_controller"),
                                                   [&](const Action& xrAction, XrPath binding, ActionSource& source) {
                                                       return mapPathToTouchControllerInputState(
-                                                          xrAction, getXrPath(binding), source);
+                                                          xrAction, std::string(getXrPath(binding)), source);
                                                   });
 
         // Virtual mappings to Touch controller.
@@ -55,7 +55,7 @@ namespace virtualdesktop_openxr {
             std::make_pair("/interaction_profiles/valve/index_controller",
                            "/interaction_profiles/oculus/touch_controller"),
             [&](const Action& xrAction, XrPath binding, ActionSource& source) {
-                const auto remapped = remapIndexControllerToTouchController(getXrPath(binding));
+                const auto remapped = remapIndexControllerToTouchController(std::string(getXrPath(binding)));
                 if (remapped.has_value()) {
                     return mapPathToTouchControllerInputState(xrAction, remapped.value(), source);
                 }
@@ -65,7 +65,7 @@ namespace virtualdesktop_openxr {
             std::make_pair("/interaction_profiles/htc/vive_controller",
                            "/interaction_profiles/oculus/touch_controller"),
             [&](const Action& xrAction, XrPath binding, ActionSource& source) {
-                const auto remapped = remapViveControllerToTouchController(getXrPath(binding));
+                const auto remapped = remapViveControllerToTouchController(std::string(getXrPath(binding)));
                 if (remapped.has_value()) {
                     return mapPathToTouchControllerInputState(xrAction, remapped.value(), source);
                 }
@@ -75,7 +75,7 @@ namespace virtualdesktop_openxr {
             std::make_pair("/interaction_profiles/microsoft/motion_controller",
                            "/interaction_profiles/oculus/touch_controller"),
             [&](const Action& xrAction, XrPath binding, ActionSource& source) {
-                const auto remapped = remapMicrosoftMotionControllerToTouchController(getXrPath(binding));
+                const auto remapped = remapMicrosoftMotionControllerToTouchController(std::string(getXrPath(binding)));
                 if (remapped.has_value()) {
                     return mapPathToTouchControllerInputState(xrAction, remapped.value(), source);
                 }
@@ -85,7 +85,7 @@ namespace virtualdesktop_openxr {
             std::make_pair("/interaction_profiles/khr/simple_controller",
                            "/interaction_profiles/oculus/touch_controller"),
             [&](const Action& xrAction, XrPath binding, ActionSource& source) {
-                const auto remapped = remapSimpleControllerToTouchController(getXrPath(binding));
+                const auto remapped = remapSimpleControllerToTouchController(std::string(getXrPath(binding)));
                 if (remapped.has_value()) {
                     return mapPathToTouchControllerInputState(xrAction, remapped.value(), source);
                 }
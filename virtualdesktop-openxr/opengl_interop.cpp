@@ -310,16 +310,21 @@ namespace virtualdesktop_openxr {
         glFinish();
     }
 
-    // Serialize commands from the OpenGL context to the D3D11 context used by OVR.
-    void OpenXrRuntime::serializeOpenGLFrame() {
+    // Signal the next fence value from the OpenGL context, without waiting.
+    void OpenXrRuntime::signalOpenGLContext() {
         GlContextSwitch context(m_glContext);
 
         m_fenceValue++;
-        TraceLoggingWrite(
-            g_traceProvider, "xrEndFrame_Sync", TLArg("OpenGL", "Api"), TLArg(m_fenceValue, "FenceValue"));
         m_glDispatch.glSemaphoreParameterui64vEXT(m_glSemaphore, GL_D3D12_FENCE_VALUE_EXT, &m_fenceValue);
         m_glDispatch.glSignalSemaphoreEXT(m_glSemaphore, 0, nullptr, 0, nullptr, nullptr);
         glFlush();
+    }
+
+    // Serialize commands from the OpenGL context to the D3D11 context used by OVR.
+    void OpenXrRuntime::serializeOpenGLFrame() {
+        signalOpenGLContext();
+        TraceLoggingWrite(
+            g_traceProvider, "xrEndFrame_Sync", TLArg("OpenGL", "Api"), TLArg(m_fenceValue, "FenceValue"));
 
         waitOnSubmissionDevice();
     }
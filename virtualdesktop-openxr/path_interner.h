@@ -0,0 +1,150 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "pch.h"
+
+namespace virtualdesktop_openxr::utils {
+
+    // A string table for XrPath. Strings are stored (null-terminated) in a chunked arena that never relocates, so the
+    // views that are returned remain valid for the lifetime of the interner. XrPath values are handed out sequentially
+    // starting at 1 and are never recycled.
+    class PathInterner {
+      public:
+        PathInterner() {
+            m_slots.resize(k_initialSlots, 0);
+        }
+
+        // Return the existing path for a string, or XR_NULL_PATH if it was never interned.
+        XrPath find(std::string_view str) const {
+            const uint64_t hash = hashString(str);
+            for (size_t i = hash & (m_slots.size() - 1);; i = (i + 1) & (m_slots.size() - 1)) {
+                const uint32_t id = m_slots[i];
+                if (!id) {
+                    return XR_NULL_PATH;
+                }
+                const Entry& entry = m_entries[id - 1];
+                if (entry.hash == hash && entry.str == str) {
+                    return (XrPath)id;
+                }
+            }
+        }
+
+        // Return the path for a string, interning it if needed.
+        XrPath intern(std::string_view str) {
+            const XrPath existing = find(str);
+            if (existing != XR_NULL_PATH) {
+                return existing;
+            }
+
+            // Keep the load factor under 1/2 to keep the probe sequences short.
+            if ((m_entries.size() + 1) * 2 > m_slots.size()) {
+                rehash(m_slots.size() * 2);
+            }
+
+            Entry entry;
+            entry.str = store(str);
+            entry.hash = hashString(str);
+            m_entries.push_back(entry);
+            const uint32_t id = (uint32_t)m_entries.size();
+            insertSlot(entry.hash, id);
+
+            return (XrPath)id;
+        }
+
+        // Return the string for a path. The view is null-terminated.
+        std::optional<std::string_view> lookup(XrPath path) const {
+            if (path == XR_NULL_PATH || path > m_entries.size()) {
+                return {};
+            }
+            return m_entries[(size_t)path - 1].str;
+        }
+
+        bool contains(XrPath path) const {
+            return path != XR_NULL_PATH && path <= m_entries.size();
+        }
+
+        size_t size() const {
+            return m_entries.size();
+        }
+
+      private:
+        struct Entry {
+            std::string_view str;
+            uint64_t hash;
+        };
+
+        static constexpr size_t k_initialSlots = 256;
+        static constexpr size_t k_chunkSize = 64 * 1024;
+
+        // FNV-1a.
+        static uint64_t hashString(std::string_view str) {
+            uint64_t hash = 14695981039346656037ull;
+            for (const char c : str) {
+                hash ^= (uint8_t)c;
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+
+        void insertSlot(uint64_t hash, uint32_t id) {
+            size_t i = hash & (m_slots.size() - 1);
+            while (m_slots[i]) {
+                i = (i + 1) & (m_slots.size() - 1);
+            }
+            m_slots[i] = id;
+        }
+
+        void rehash(size_t newSize) {
+            m_slots.assign(newSize, 0);
+            for (uint32_t i = 0; i < m_entries.size(); i++) {
+                insertSlot(m_entries[i].hash, i + 1);
+            }
+        }
+
+        std::string_view store(std::string_view str) {
+            const size_t needed = str.size() + 1;
+            if (m_chunks.empty() || m_chunkUsed + needed > m_chunkCapacity) {
+                m_chunkCapacity = std::max(k_chunkSize, needed);
+                m_chunks.push_back(std::make_unique<char[]>(m_chunkCapacity));
+                m_chunkUsed = 0;
+            }
+
+            char* const data = m_chunks.back().get() + m_chunkUsed;
+            memcpy(data, str.data(), str.size());
+            data[str.size()] = '\0';
+            m_chunkUsed += needed;
+
+            return std::string_view(data, str.size());
+        }
+
+        // Open-addressing table (linear probing) of 1-based indices into m_entries. 0 marks an empty slot.
+        std::vector<uint32_t> m_slots;
+        std::vector<Entry> m_entries;
+
+        std::vector<std::unique_ptr<char[]>> m_chunks;
+        size_t m_chunkCapacity{0};
+        size_t m_chunkUsed{0};
+    };
+
+} // namespace virtualdesktop_openxr::utils
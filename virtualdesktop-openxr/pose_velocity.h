@@ -0,0 +1,73 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "pch.h"
+
+namespace virtualdesktop_openxr::utils {
+
+    // Rigid body velocity composition. An XrSpaceVelocity describes the motion of the origin of a frame, with both its
+    // angular and linear velocities expressed in the parent frame. Poses follow the xr::math convention, where
+    // Pose::Multiply(a, b) places a within b.
+
+    // Move the velocity of a frame to a frame attached at a fixed offset within it, ie: the velocity that goes with
+    // Pose::Multiply(offset, pose). The angular velocity is shared, and the linear velocity gains the tangential term
+    // ω × r, where r is the lever arm of the offset in the parent frame.
+    inline void ApplyOffsetToVelocity(const XrPosef& offset, const XrPosef& pose, XrSpaceVelocity& velocity) {
+        using namespace DirectX;
+
+        const XMVECTOR angularVelocity = xr::math::LoadXrVector3(velocity.angularVelocity);
+        const XMVECTOR leverArm =
+            XMVector3Rotate(xr::math::LoadXrVector3(offset.position), xr::math::LoadXrQuaternion(pose.orientation));
+        xr::math::StoreXrVector3(
+            &velocity.linearVelocity,
+            XMVectorAdd(xr::math::LoadXrVector3(velocity.linearVelocity), XMVector3Cross(angularVelocity, leverArm)));
+    }
+
+    // Make the velocity of a frame relative to a base frame, given both poses and velocities in a common parent frame,
+    // ie: the velocity that goes with Pose::Multiply(pose, Pose::Invert(basePose)). The result is expressed in the base
+    // frame, and accounts for the base frame rotating around the origin of the frame (-ω_base × (p - p_base)).
+    inline void MakeVelocityRelative(const XrPosef& pose,
+                                     XrSpaceVelocity& velocity,
+                                     const XrPosef& basePose,
+                                     const XrSpaceVelocity& baseVelocity) {
+        using namespace DirectX;
+
+        const XMVECTOR baseOrientationInverse =
+            XMQuaternionConjugate(xr::math::LoadXrQuaternion(basePose.orientation));
+        const XMVECTOR baseAngularVelocity = xr::math::LoadXrVector3(baseVelocity.angularVelocity);
+        const XMVECTOR offset =
+            XMVectorSubtract(xr::math::LoadXrVector3(pose.position), xr::math::LoadXrVector3(basePose.position));
+
+        const XMVECTOR angularVelocity =
+            XMVectorSubtract(xr::math::LoadXrVector3(velocity.angularVelocity), baseAngularVelocity);
+        const XMVECTOR linearVelocity = XMVectorSubtract(
+            XMVectorSubtract(xr::math::LoadXrVector3(velocity.linearVelocity),
+                             xr::math::LoadXrVector3(baseVelocity.linearVelocity)),
+            XMVector3Cross(baseAngularVelocity, offset));
+
+        xr::math::StoreXrVector3(&velocity.angularVelocity, XMVector3Rotate(angularVelocity, baseOrientationInverse));
+        xr::math::StoreXrVector3(&velocity.linearVelocity, XMVector3Rotate(linearVelocity, baseOrientationInverse));
+    }
+
+} // namespace virtualdesktop_openxr::utils
@@ -0,0 +1,129 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "pch.h"
+
+namespace virtualdesktop_openxr::utils {
+
+    // A pool of released objects waiting to be reused by a compatible request, instead of being freed and created
+    // again. Each parked object is gated by a GPU fence value (it may still be in use until the fence completes), and
+    // the pool is bounded by a memory budget and by the age of its entries. Evicted objects are handed back to the
+    // caller to be freed.
+    template <typename Key, typename T>
+    class RecyclingPool {
+      public:
+        void setLimits(uint64_t budget, double maxAge) {
+            m_budget = budget;
+            m_maxAge = maxAge;
+        }
+
+        bool isEnabled() const {
+            return m_budget > 0;
+        }
+
+        // Park an object. Returns the objects evicted to honor the budget (possibly the object itself, if it is larger
+        // than the budget).
+        std::vector<T> park(const Key& key, T object, uint64_t size, uint64_t fenceValue, double now) {
+            m_entries.push_back({key, std::move(object), size, fenceValue, now});
+            m_size += size;
+
+            std::vector<T> evicted;
+            while (m_size > m_budget) {
+                evicted.push_back(evictOldest());
+            }
+            return evicted;
+        }
+
+        // Take the oldest compatible object whose fence has completed.
+        std::optional<T> take(const Key& key, uint64_t completedFenceValue) {
+            for (auto it = m_entries.begin(); it != m_entries.end(); it++) {
+                if (it->key == key && it->fenceValue <= completedFenceValue) {
+                    T object = std::move(it->object);
+                    m_size -= it->size;
+                    m_entries.erase(it);
+                    m_hits++;
+                    return object;
+                }
+            }
+            m_misses++;
+            return {};
+        }
+
+        // Evict the objects parked for longer than the maximum age.
+        std::vector<T> evictExpired(double now) {
+            std::vector<T> evicted;
+            while (!m_entries.empty() && now - m_entries.front().parkTime > m_maxAge) {
+                evicted.push_back(evictOldest());
+            }
+            return evicted;
+        }
+
+        std::vector<T> clear() {
+            std::vector<T> evicted;
+            while (!m_entries.empty()) {
+                evicted.push_back(evictOldest());
+            }
+            return evicted;
+        }
+
+        size_t getCount() const {
+            return m_entries.size();
+        }
+        uint64_t getSize() const {
+            return m_size;
+        }
+        uint64_t getHits() const {
+            return m_hits;
+        }
+        uint64_t getMisses() const {
+            return m_misses;
+        }
+
+      private:
+        struct Entry {
+            Key key;
+            T object;
+            uint64_t size;
+            uint64_t fenceValue;
+            double parkTime;
+        };
+
+        T evictOldest() {
+            T object = std::move(m_entries.front().object);
+            m_size -= m_entries.front().size;
+            m_entries.pop_front();
+            return object;
+        }
+
+        // Ordered from the oldest to the most recently parked.
+        std::deque<Entry> m_entries;
+        uint64_t m_size{0};
+        uint64_t m_budget{0};
+        double m_maxAge{0.0};
+
+        uint64_t m_hits{0};
+        uint64_t m_misses{0};
+    };
+
+} // namespace virtualdesktop_openxr::utils
@@ -29,6 +29,21 @@
 #include "BodyState.h"
 #include <hand_simulation.h>
 #include "trackers.h"
+#include "path_interner.h"
+#include "body_state_history.h"
+#include "frame_pacing.h"
+#include "frame_compositor.h"
+#include "mailbox.h"
+#include "frame_arena.h"
+#include "frame_metrics.h"
+#include "timeline_recorder.h"
+#include "joint_transform.h"
+#include "pose_velocity.h"
+#include "swapchain_index_tracker.h"
+#include "alpha_correction.h"
+#include "view_cache.h"
+#include "recycling_pool.h"
+#include "deferred_release_queue.h"
 
 #include <RuntimeConfiguration.h>
 
@@ -51,6 +66,9 @@ namespace virtualdesktop_openxr {
         OpenXrRuntime();
         ~OpenXrRuntime();
 
+        // Upon DLL_PROCESS_DETACH, the log writer thread must not be waited on.
+        void detachLogWriter();
+
         XrResult xrGetInstanceProcAddr(XrInstance instance, const char* name, PFN_xrVoidFunction* function);
 
         XrResult xrEnumerateInstanceExtensionProperties(const char* layerName,
@@ -302,11 +320,11 @@ namespace virtualdesktop_openxr {
             ovrTextureSwapChain ovrSwapchain;
             std::vector<ComPtr<ID3D11Texture2D>> images;
 
-            // Resources for copy/resolve/pre-processing.
-            std::vector<ComPtr<ID3D11ShaderResourceView>> srvs;
-            std::vector<ComPtr<ID3D11UnorderedAccessView>> uavs;
-            std::vector<ComPtr<ID3D11RenderTargetView>> rtvs;
-            std::vector<ComPtr<ID3D11DepthStencilView>> dsvs;
+            // The state of the OVR image ring, to schedule commits without polling.
+            SwapchainIndexTracker indexTracker;
+
+            // What was last copied and/or processed into this slice.
+            std::optional<PreprocessedImage> lastPreprocessed;
         };
 
         struct Swapchain {
@@ -323,6 +341,7 @@ namespace virtualdesktop_openxr {
             int lastWaitedIndex{-1};
             int lastReleasedIndex{-1};
             uint32_t nextIndex{0};
+            uint64_t releaseCount{0};
 
             // For precompositor needs (drawing our own stereo projection).
             SwapchainSlice stereoProjection[xr::StereoView::Count];
@@ -344,9 +363,45 @@ namespace virtualdesktop_openxr {
             ovrTextureSwapChainDesc ovrDesc;
         };
 
+        // The properties that a destroyed swapchain must match to be recycled by xrCreateSwapchain().
+        struct SwapchainPoolKey {
+            XrSwapchainCreateFlags createFlags;
+            XrSwapchainUsageFlags usageFlags;
+            int64_t format;
+            uint32_t sampleCount;
+            uint32_t width;
+            uint32_t height;
+            uint32_t faceCount;
+            uint32_t arraySize;
+            uint32_t mipCount;
+
+            SwapchainPoolKey(const XrSwapchainCreateInfo& createInfo)
+                : createFlags(createInfo.createFlags), usageFlags(createInfo.usageFlags), format(createInfo.format),
+                  sampleCount(createInfo.sampleCount), width(createInfo.width), height(createInfo.height),
+                  faceCount(createInfo.faceCount), arraySize(createInfo.arraySize), mipCount(createInfo.mipCount) {
+            }
+
+            bool operator==(const SwapchainPoolKey& other) const {
+                return createFlags == other.createFlags && usageFlags == other.usageFlags && format == other.format &&
+                       sampleCount == other.sampleCount && width == other.width && height == other.height &&
+                       faceCount == other.faceCount && arraySize == other.arraySize && mipCount == other.mipCount;
+            }
+        };
+
+        struct VisibilityMask {
+            // The eye parameters the mesh was generated for.
+            bool isValid{false};
+            ovrHmdType hmdType{ovrHmd_None};
+            ovrFovPort fov{};
+            ovrQuatf hmdToEyeRotation{};
+
+            std::vector<XrVector2f> vertices;
+            std::vector<uint32_t> indices;
+        };
+
         struct PrecompositorState {
             // State for the current frame.
-            std::set<std::pair<Swapchain*, uint32_t>> processedSwapchainImages;
+            ArenaVector<std::pair<Swapchain*, uint32_t>> processedSwapchainImages;
             XrTime displayTime{0};
             bool isProj0SRGB{false};
             bool isFirstProjectionLayer{true};
@@ -373,9 +428,38 @@ namespace virtualdesktop_openxr {
             std::string realPath;
         };
 
+        enum class ActionBindingKind : uint8_t {
+            Button,
+            Float,
+            Vector2f,
+            ControllerPose,
+            TrackerPose,
+            EyeGazePose,
+        };
+
+        // A binding resolved ahead of time by compileActionBindings(), so that xrGetActionState*() do not need to
+        // look at the action source paths.
+        struct ActionBinding {
+            ActionBindingKind kind;
+            XrPath subactionPath{XR_NULL_PATH};
+            int side{-1};
+
+            // Byte offset of the value within ActionSet::cachedInputState.
+            uint32_t offset{0};
+            uint32_t buttonMask{0};
+            float threshold{0.f};
+
+            // Identifies the physical input for arbitration between action sets (0 for poses, never arbitrated).
+            uint64_t sourceId{0};
+
+            // Whether an action set with a higher priority owned the input at the last xrSyncActions().
+            bool isSuppressed{false};
+        };
+
         struct ActionSet {
             std::string name;
             std::string localizedName;
+            uint32_t priority{0};
 
             std::set<XrPath> subactionPaths;
 
@@ -399,15 +483,20 @@ namespace virtualdesktop_openxr {
             bool lastBoolValue[xr::Side::Count]{false, false};
             XrTime lastBoolValueChangedTime[xr::Side::Count]{0, 0};
 
+            // The getters update the last values while only holding m_actionsAndSpacesMutex shared.
+            std::mutex lastValueMutex;
+
             std::set<XrPath> subactionPaths;
             std::map<std::string, ActionSource> actionSources;
+            std::vector<ActionBinding> bindings;
         };
 
         struct Haptic {
-            std::chrono::high_resolution_clock::time_point startTime{};
+            std::chrono::high_resolution_clock::time_point deadline{};
+            std::chrono::high_resolution_clock::time_point lastSubmitTime{};
             float frequency{0.f};
             float amplitude{0.f};
-            int64_t duration{0};
+            bool isDirty{false};
         };
 
         struct HandTracker {
@@ -427,6 +516,28 @@ namespace virtualdesktop_openxr {
             XrBodyTrackingFidelityMETA maxFidelity{XR_BODY_TRACKING_FIDELITY_LOW_META};
         };
 
+        // The tracking state at a given time, shared by all the locate calls targeting that time.
+        struct TrackingSnapshot {
+            bool isValid{false};
+            XrTime time{0};
+            ovrTrackingOrigin originType{ovrTrackingOrigin_EyeLevel};
+            float eyeHeight{OVR_DEFAULT_EYE_HEIGHT};
+
+            // Indexed by HMD, left controller, right controller. Device poses are filled on-demand.
+            bool hasDevicePose[3]{};
+            ovrResult devicePoseResult[3]{};
+            ovrPoseStatef devicePose[3]{};
+        };
+
+        struct TrackingSnapshotCache {
+            // Requests within this window are considered to target the same time.
+            static constexpr XrDuration k_timeTolerance = 100'000; // 100us
+
+            // Most apps locate at a single time per frame, but some alternate between a couple of times.
+            TrackingSnapshot snapshots[2];
+            uint32_t nextSnapshot{0};
+        };
+
         enum class EyeTracking {
             None = 0,
             Mmf,
@@ -447,6 +558,9 @@ namespace virtualdesktop_openxr {
         void initializeSystem();
         void initializeBodyTrackingMmf();
         void bodyStateWatcherThread();
+        bool getBodyState(XrTime time, BodyTracking::BodyStateV2& state) const;
+        XrTime getBodyStateSampleTime(XrTime time, double maxPrediction) const;
+        bool getLatestBodyState(BodyTracking::BodyStateV2& state) const;
 
         // session.cpp
         void updateSessionState(bool forceSendEvent = false);
@@ -454,10 +568,20 @@ namespace virtualdesktop_openxr {
 
         // action.cpp
         void rebindControllerActions(int side);
-        std::string getXrPath(XrPath path) const;
-        XrPath stringToPath(const std::string& path, bool validate = false);
-        int getActionSide(const std::string& fullPath, bool allowExtraPaths = false) const;
-        bool isActionEyeTracker(const std::string& fullPath) const;
+        std::string_view getXrPath(XrPath path) const;
+        XrPath stringToPath(std::string_view path, bool validate = false);
+        int getActionSide(std::string_view fullPath, bool allowExtraPaths = false) const;
+        bool isActionEyeTracker(std::string_view fullPath) const;
+
+        // action_bindings.cpp
+        void compileActionBindings(Action& xrAction) const;
+        void arbitrateActionSets(const XrActionsSyncInfo& syncInfo);
+
+        // haptics.cpp
+        void startHapticsThread();
+        void stopHapticsThread();
+        void scheduleVibration(int side, float frequency, float amplitude, XrDuration duration);
+        void hapticsThread();
 
         // mappings.cpp
         void initializeRemappingTables();
@@ -486,19 +610,32 @@ namespace virtualdesktop_openxr {
         XrSpaceLocationFlags getHmdPose(XrTime time, XrPosef& pose, XrSpaceVelocity* velocity) const;
         XrSpaceLocationFlags getControllerPose(int side, XrTime time, XrPosef& pose, XrSpaceVelocity* velocity) const;
         XrSpaceLocationFlags getEyeTrackerPose(XrTime time, XrPosef& pose, XrEyeGazeSampleTimeEXT* sampleTime) const;
+        TrackingSnapshot& getTrackingSnapshot(XrTime time) const;
+        ovrResult getDevicePose(ovrTrackedDeviceType device, XrTime time, ovrPoseStatef& state) const;
+        void getTrackingOrigin(XrTime time, ovrTrackingOrigin& originType, float& eyeHeight) const;
+        void invalidateTrackingSnapshots();
 
         // eye_tracking.cpp
         bool getEyeGaze(XrTime time, bool getStateOnly, XrVector3f& unitVector, XrTime& sampleTime) const;
 
         // hand_tracking.cpp
-        void processHandGestures(uint32_t side);
-        bool getPinchPose(int side, const XrPosef& controllerPose, XrPosef& pose) const;
+        void processHandGestures(uint32_t side, ovrInputState& inputState) const;
+        bool getPinchPose(int side, XrTime time, const XrPosef& controllerPose, XrPosef& pose) const;
 
         // body_tracking.cpp
-        int getTrackerIndex(const std::string& path) const;
+        int getTrackerIndex(std::string_view path) const;
         bool isTrackerEnabled(uint32_t index) const;
         XrSpaceLocationFlags getBodyJointPose(XrFullBodyJointMETA joint, XrTime time, XrPosef& pose) const;
 
+        // swapchain.cpp
+        std::vector<Swapchain*> parkSwapchain(Swapchain& xrSwapchain);
+        uint64_t signalReleaseFence();
+        void releaseSwapchains(const std::vector<Swapchain*>& swapchains);
+        void releaseCompletedSwapchains();
+        void drainSwapchainReleases();
+        void freeSwapchain(Swapchain& xrSwapchain);
+        uint64_t getSwapchainMemorySize(const Swapchain& xrSwapchain) const;
+
         // frame.cpp
         XrResult handleProjectionLayer(const XrCompositionLayerProjection& proj, ovrLayer_Union& layer);
         XrResult handleQuadCylinderLayer(const XrCompositionLayerQuad& quad,
@@ -507,6 +644,7 @@ namespace virtualdesktop_openxr {
         XrResult handleCubeLayer(const XrCompositionLayerCubeKHR& cube, ovrLayer_Union& layer);
         void asyncSubmissionThread();
         void waitForAsyncSubmissionIdle(bool doRunningStart = false);
+        void exportFrameMetrics(const FrameMetricsRecorder& frameMetrics) const;
 
         // d3d11_native.cpp
         XrResult initializeD3D11(const XrGraphicsBindingD3D11KHR& d3dBindings);
@@ -519,8 +657,10 @@ namespace virtualdesktop_openxr {
         void preprocessSwapchainImage(Swapchain& xrSwapchain,
                                       uint32_t layerIndex,
                                       uint32_t slice,
+                                      const XrRect2Di* imageRect,
                                       XrCompositionLayerFlags compositionFlags,
-                                      std::set<std::pair<Swapchain*, uint32_t>>& processed);
+                                      ArenaVector<std::pair<Swapchain*, uint32_t>>& processed);
+        void commitSwapchainImages(const ArenaVector<std::pair<Swapchain*, uint32_t>>& processed);
         void ensureSwapchainSliceResources(Swapchain& xrSwapchain, uint32_t slice) const;
         void ensureSwapchainPrecompositorResources(Swapchain& xrSwapchain) const;
         void populateSwapchainSlice(const Swapchain& xrSwapchain,
@@ -528,8 +668,19 @@ namespace virtualdesktop_openxr {
                                     SwapchainSlice& slice,
                                     uint32_t sliceIndex,
                                     const char* debugName) const;
+        ComPtr<ID3D11ShaderResourceView> getShaderResourceView(ID3D11Texture2D* texture,
+                                                               const D3D11_SHADER_RESOURCE_VIEW_DESC& desc,
+                                                               const char* debugName) const;
+        ComPtr<ID3D11UnorderedAccessView> getUnorderedAccessView(ID3D11Texture2D* texture,
+                                                                 const D3D11_UNORDERED_ACCESS_VIEW_DESC& desc,
+                                                                 const char* debugName) const;
+        ComPtr<ID3D11DepthStencilView> getDepthStencilView(ID3D11Texture2D* texture,
+                                                           const D3D11_DEPTH_STENCIL_VIEW_DESC& desc,
+                                                           const char* debugName) const;
+        void evictSwapchainViews(const Swapchain& xrSwapchain);
         void flushD3D11Context();
         void flushSubmissionContext();
+        void signalD3D11Context();
         void serializeD3D11Frame();
         void waitOnSubmissionDevice();
         bool requireNTHandleSharing() const;
@@ -540,6 +691,7 @@ namespace virtualdesktop_openxr {
         bool isD3D12Session() const;
         XrResult getSwapchainImagesD3D12(Swapchain& xrSwapchain, XrSwapchainImageD3D12KHR* d3d12Images, uint32_t count);
         void flushD3D12CommandQueue();
+        void signalD3D12CommandQueue();
         void serializeD3D12Frame();
 
         // vulkan_interop.cpp
@@ -550,6 +702,7 @@ namespace virtualdesktop_openxr {
         XrResult getSwapchainImagesVulkan(Swapchain& xrSwapchain, XrSwapchainImageVulkanKHR* vkImages, uint32_t count);
         void cleanupSwapchainImagesVulkan(Swapchain& xrSwapchain);
         void flushVulkanCommandQueue();
+        void signalVulkanCommandQueue();
         void serializeVulkanFrame();
 
         // opengl_interop.cpp
@@ -560,9 +713,12 @@ namespace virtualdesktop_openxr {
         XrResult getSwapchainImagesOpenGL(Swapchain& xrSwapchain, XrSwapchainImageOpenGLKHR* glImages, uint32_t count);
         void cleanupSwapchainImagesOpenGL(Swapchain& xrSwapchain);
         void flushOpenGLContext();
+        void signalOpenGLContext();
         void serializeOpenGLFrame();
 
         // visibility_mask.cpp
+        const VisibilityMask& getVisibilityMask(uint32_t viewIndex, uint32_t maskIndex);
+        void invalidateVisibilityMasks();
         void convertSteamVRToOpenXRHiddenMesh(const ovrFovPort& fov, XrVector2f* vertices, uint32_t count) const;
 
         // mirror_window.cpp
@@ -588,15 +744,17 @@ namespace virtualdesktop_openxr {
         ovrHmdDesc m_cachedHmdInfo{};
         ovrEyeRenderDesc m_cachedEyeInfo[xr::StereoView::Count]{};
         ovrSizei m_cachedProjectionResolution{};
+        std::mutex m_visibilityMaskMutex;
+        VisibilityMask m_visibilityMasks[xr::StereoView::Count][3];
         mutable std::optional<float> m_lastKnownFloorHeight;
         LARGE_INTEGER m_qpcFrequency{};
         double m_ovrTimeFromQpcTimeOffset{0};
-        XrPath m_stringIndex{0};
         using MappingFunction = std::function<bool(const Action&, XrPath, ActionSource&)>;
         using CheckValidPathFunction = std::function<bool(const std::string&)>;
         std::map<std::pair<std::string, std::string>, MappingFunction> m_controllerMappingTable;
         std::map<std::string, CheckValidPathFunction> m_controllerValidPathsTable;
         wil::unique_registry_watcher m_registryWatcher;
+        std::thread m_logWriterThread;
         bool m_loggedResolution{false};
         std::string m_applicationName;
         std::string m_exeName;
@@ -618,6 +776,7 @@ namespace virtualdesktop_openxr {
         ovrTextureSwapChain m_headlessSwapchain{nullptr};
         bool m_allowStaticSwapchainsReuse{false};
         bool m_forceSlowpathSwapchains{false};
+        bool m_useSmallAlphaCorrectionGroups{false};
 
         // Session state.
         bool m_isHeadless{false};
@@ -636,6 +795,7 @@ namespace virtualdesktop_openxr {
         ComPtr<ID3D11Buffer> m_resolveMultisampledDepthConstants;
         ComPtr<ID3D11ComputeShader> m_alphaCorrectShader;
         ComPtr<ID3D11Buffer> m_alphaCorrectConstants;
+        mutable LruCache<ViewKey, ComPtr<ID3D11View>, ViewKeyHash> m_viewCache;
         ComPtr<IDXGISwapChain1> m_dxgiSwapchain;
         bool m_sessionCreated{false};
         XrSessionState m_sessionState{XR_SESSION_STATE_UNKNOWN};
@@ -647,11 +807,12 @@ namespace virtualdesktop_openxr {
         bool m_sessionExiting{false};
         XrFovf m_cachedEyeFov[xr::StereoView::Count];
         std::shared_mutex m_actionsAndSpacesMutex;
-        std::map<XrPath, std::string> m_strings; // protected by actionsAndSpacesMutex
+        PathInterner m_strings; // protected by actionsAndSpacesMutex
         std::set<XrActionSet> m_actionSets;
         std::set<XrActionSet> m_activeActionSets;
         std::set<XrAction> m_actions;
         std::set<XrAction> m_actionsForCleanup;
+        std::unordered_map<uint64_t, uint32_t> m_inputSourceOwners; // protected by actionsAndSpacesMutex
         std::shared_mutex m_handTrackersMutex;
         std::set<XrHandTrackerEXT> m_handTrackers;
         std::set<XrSpace> m_spaces;
@@ -679,18 +840,22 @@ namespace virtualdesktop_openxr {
         bool m_currentInteractionProfileDirty{false};
         bool m_hasEyeTrackerBindings{false};
         bool m_hasViveTrackerBindings{false};
-        Haptic m_currentVibration[xr::Side::Count];
         bool m_shouldUseDepth{true};
         bool m_useRunningStart{true};
+        RunningStartPolicy m_runningStartPolicy{RunningStartPolicy::Ewma};
         bool m_jiggleViewRotations{false};
+        BodyStateHistory::PredictionLimits m_bodyStatePrediction;
         MyHandSimulation m_handSimulation[xr::Side::Count];
         PrecompositorState m_precompositor;
+        FrameArena m_frameArena;
         uint32_t m_shouldRecenter{false};
         XrTime m_recenterTime{0};
 
         // Swapchains and other graphics stuff.
         std::mutex m_swapchainsMutex;
         std::set<XrSwapchain> m_swapchains;
+        RecyclingPool<SwapchainPoolKey, Swapchain*> m_swapchainPool;
+        DeferredReleaseQueue<Swapchain*> m_swapchainReleaseQueue;
 
         // Mirror window.
         bool m_useMirrorWindow{false};
@@ -705,19 +870,27 @@ namespace virtualdesktop_openxr {
         // Async submission thread.
         bool m_useAsyncSubmission{false};
         bool m_needStartAsyncSubmissionThread{false};
-        bool m_terminateAsyncThread{false};
         std::thread m_asyncSubmissionThread;
-        std::mutex m_asyncSubmissionMutex;
-        std::condition_variable m_asyncSubmissionCondVar;
-        std::vector<ovrLayer_Union> m_layersForAsyncSubmission;
+        TripleBufferMailbox<ovrLayer_Union, ovrMaxLayerCount> m_layersForAsyncSubmission;
         std::chrono::high_resolution_clock::time_point m_lastWaitToBeginFrameTime{};
+        RunningStartController m_runningStart;
+        std::unique_ptr<IFrameCompositor> m_frameCompositor;
+        FrameLoopValidator* m_frameLoopValidator{nullptr};
 
         // Body tracking thread.
         bool m_terminateBodyStateThread{false};
         std::thread m_bodyStateWatcherThread;
-        mutable std::shared_mutex m_bodyStateMutex;
+        BodyStateHistory m_bodyStateHistory;
         wil::unique_handle m_bodyStateEvent;
 
+        // Haptics thread.
+        std::mutex m_hapticsMutex;
+        Haptic m_currentVibration[xr::Side::Count]; // protected by hapticsMutex
+        bool m_terminateHapticsThread{false};       // protected by hapticsMutex
+        std::thread m_hapticsThread;
+        wil::unique_handle m_hapticsWakeEvent;
+        wil::unique_handle m_hapticsTimer;
+
         // Graphics API interop.
         ComPtr<ID3D11Device5> m_d3d11Device;
         ComPtr<ID3D11DeviceContext4> m_d3d11Context;
@@ -765,9 +938,10 @@ namespace virtualdesktop_openxr {
         uint64_t m_lastCpuFrameTimeUs{0};
         uint64_t m_lastGpuFrameTimeUs{0};
         ovrInputState m_cachedInputState;
-        BodyTracking::BodyStateV2 m_cachedBodyState{};
         XrTime m_lastPredictedDisplayTime{0};
         mutable std::optional<XrPosef> m_lastValidHmdPose;
+        mutable std::mutex m_trackingSnapshotMutex;
+        mutable TrackingSnapshotCache m_trackingSnapshotCache;
 
         // Statistics.
         double m_sessionStartTime{0.0};
@@ -779,6 +953,15 @@ namespace virtualdesktop_openxr {
         std::unique_ptr<ITimer> m_gpuTimerApp[k_numGpuTimers];
         std::unique_ptr<ITimer> m_gpuTimerPrecomposition[k_numGpuTimers];
         uint32_t m_currentTimerIndex{0};
+        uint64_t m_lastWaitFrameTimeUs{0};
+        double m_lastCompositorTimeUs{0};
+        uint32_t m_lastDroppedFrameCount{0};
+        bool m_isAsyncReprojectionActive{false};
+        std::unique_ptr<FrameMetricsRecorder> m_frameMetrics;
+        TimelineRecorder m_timeline;
+        std::atomic<bool> m_exportFrameMetricsSetting{false};
+        std::atomic<bool> m_frameMetricsExportRequested{false};
+        std::future<void> m_frameMetricsExport;
     };
 
     // Singleton accessor.
@@ -154,6 +154,37 @@ namespace virtualdesktop_openxr {
         // Read configuration and set up the session accordingly.
         refreshSettings();
 
+        m_frameCompositor = std::make_unique<OvrFrameCompositor>(m_ovrSession);
+#ifdef _DEBUG
+        if (const auto faults = getSetting("inject_compositor_faults").value_or(0)) {
+            Log("Injecting compositor faults: 0x%x\n", faults);
+            m_frameCompositor = std::make_unique<FaultInjectingFrameCompositor>(
+                std::move(m_frameCompositor), (uint32_t)faults, m_idealFrameDuration);
+        }
+#endif
+        if (getSetting("validate_frame_loop").value_or(false)) {
+            auto validator = std::make_unique<FrameLoopValidator>(std::move(m_frameCompositor));
+            m_frameLoopValidator = validator.get();
+            m_frameCompositor = std::move(validator);
+        }
+        m_frameArena.setPoisoning(getSetting("poison_frame_arena").value_or(false));
+        m_swapchainPool.setLimits(std::max(getSetting("swapchain_pool_budget_mb").value_or(512), 0) * 1024ull * 1024ull,
+                                  std::max(getSetting("swapchain_pool_max_age_s").value_or(30), 0));
+        m_frameMetrics.reset();
+        if (getSetting("record_frame_metrics").value_or(false)) {
+            m_frameMetrics = std::make_unique<FrameMetricsRecorder>();
+        }
+        if (getSetting("record_frame_timeline").value_or(false)) {
+            const auto timelinePath = programData / "OpenXR-Timeline.bin";
+            if (m_timeline.start(timelinePath)) {
+                Log("Recording frame timeline to %ls\n", timelinePath.c_str());
+            } else {
+                ErrorLog("Failed to create %ls\n", timelinePath.c_str());
+            }
+        }
+
+        startHapticsThread();
+
         m_sessionCreated = true;
 
         // FIXME: Reset the session and frame state here.
@@ -208,17 +239,22 @@ namespace virtualdesktop_openxr {
         }
 
         if (m_useAsyncSubmission && !m_needStartAsyncSubmissionThread) {
-            {
-                std::unique_lock lock(m_asyncSubmissionMutex);
-
-                m_terminateAsyncThread = true;
-                m_asyncSubmissionCondVar.notify_all();
-            }
+            m_layersForAsyncSubmission.terminate();
             m_asyncSubmissionThread.join();
             m_asyncSubmissionThread = {};
             m_needStartAsyncSubmissionThread = true;
         }
 
+        if (m_frameMetricsExport.valid()) {
+            m_frameMetricsExport.wait();
+            m_frameMetricsExport = {};
+        }
+        if (m_frameMetrics) {
+            exportFrameMetrics(*m_frameMetrics);
+        }
+        m_timeline.stop();
+        stopHapticsThread();
+
         // Shutdown the body state watcher.
         if (m_bodyStateWatcherThread.joinable()) {
             m_terminateBodyStateThread = true;
@@ -274,6 +310,16 @@ namespace virtualdesktop_openxr {
             // deadlocks.
             CHECK_XRCMD(xrDestroySwapchain(*m_swapchains.begin()));
         }
+        {
+            std::unique_lock lock(m_swapchainsMutex);
+
+            TraceLoggingWrite(g_traceProvider,
+                              "SwapchainPool",
+                              TLArg(m_swapchainPool.getHits(), "Hits"),
+                              TLArg(m_swapchainPool.getMisses(), "Misses"));
+            releaseSwapchains(m_swapchainPool.clear());
+            drainSwapchainReleases();
+        }
         if (m_headlessSwapchain) {
             ovr_DestroyTextureSwapChain(m_ovrSession, m_headlessSwapchain);
         }
@@ -293,6 +339,9 @@ namespace virtualdesktop_openxr {
         m_sessionStopping = false;
         m_sessionExiting = false;
 
+        m_frameLoopValidator = nullptr;
+        m_frameCompositor.reset();
+
         // Workaround: OVR ties the last use D3D device to the OVR session, and therefore we must teardown the previous
         // OVR session to clear that state.
         ovr_Destroy(m_ovrSession);
@@ -507,6 +556,12 @@ namespace virtualdesktop_openxr {
         m_useMirrorWindow = getSetting("mirror_window").value_or(false);
 
         m_useRunningStart = !getSetting("quirk_disable_running_start").value_or(false);
+        const int runningStartPolicy = getSetting("running_start_policy").value_or((int)RunningStartPolicy::Ewma);
+        m_runningStartPolicy = RunningStartPolicy::Fixed;
+        if (runningStartPolicy == (int)RunningStartPolicy::Ewma ||
+            runningStartPolicy == (int)RunningStartPolicy::Percentile) {
+            m_runningStartPolicy = (RunningStartPolicy)runningStartPolicy;
+        }
 
         const bool shouldUseDepth =
 #ifndef IGNORE_DEPTH_SUBMISSION
@@ -520,13 +575,40 @@ namespace virtualdesktop_openxr {
 
         m_jiggleViewRotations = getSetting("jiggle_view_rotations").value_or(false);
 
+        const int bodyStatePredictionMode =
+            getSetting("body_state_prediction_mode").value_or((int)BodyStateHistory::PredictionMode::Extrapolate);
+        m_bodyStatePrediction.mode = BodyStateHistory::PredictionMode::Extrapolate;
+        if (bodyStatePredictionMode == (int)BodyStateHistory::PredictionMode::Hold ||
+            bodyStatePredictionMode == (int)BodyStateHistory::PredictionMode::Interpolate) {
+            m_bodyStatePrediction.mode = (BodyStateHistory::PredictionMode)bodyStatePredictionMode;
+        }
+        m_bodyStatePrediction.joints = getSetting("body_state_max_prediction_ms").value_or(50) / 1000.0;
+        const auto eyeGazeMaxPrediction = getSetting("eye_gaze_max_prediction_ms");
+        m_bodyStatePrediction.eyes =
+            eyeGazeMaxPrediction ? eyeGazeMaxPrediction.value() / 1000.0 : m_bodyStatePrediction.joints;
+        const auto faceMaxPrediction = getSetting("face_max_prediction_ms");
+        m_bodyStatePrediction.face =
+            faceMaxPrediction ? faceMaxPrediction.value() / 1000.0 : m_bodyStatePrediction.joints;
+
+        // Picked up by the next xrEndFrame(). Only export once each time the setting is turned on.
+        const bool shouldExportFrameMetrics = getSetting("export_frame_metrics").value_or(false);
+        const bool wasExportingFrameMetrics = m_exportFrameMetricsSetting.exchange(shouldExportFrameMetrics);
+        if (shouldExportFrameMetrics && !wasExportingFrameMetrics) {
+            m_frameMetricsExportRequested = true;
+        }
+
         TraceLoggingWrite(g_traceProvider,
                           "VDXR_Config",
                           TLArg(m_useMirrorWindow, "MirrorWindow"),
                           TLArg(m_useRunningStart, "UseRunningStart"),
+                          TLArg((int)m_runningStartPolicy, "RunningStartPolicy"),
                           TLArg(m_shouldUseDepth, "ShouldUseDepth"),
                           TLArg(m_syncGpuWorkInEndFrame, "SyncGpuWorkInEndFrame"),
-                          TLArg(m_jiggleViewRotations, "JiggleViewRotations"));
+                          TLArg(m_jiggleViewRotations, "JiggleViewRotations"),
+                          TLArg((int)m_bodyStatePrediction.mode, "BodyStatePredictionMode"),
+                          TLArg(m_bodyStatePrediction.joints, "BodyStateMaxPrediction"),
+                          TLArg(m_bodyStatePrediction.eyes, "EyeGazeMaxPrediction"),
+                          TLArg(m_bodyStatePrediction.face, "FaceMaxPrediction"));
     }
 
 } // namespace virtualdesktop_openxr
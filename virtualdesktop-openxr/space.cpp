@@ -127,7 +127,7 @@ namespace virtualdesktop_openxr {
                           "xrCreateActionSpace",
                           TLXArg(session, "Session"),
                           TLXArg(createInfo->action, "Action"),
-                          TLArg(getXrPath(createInfo->subactionPath).c_str(), "SubactionPath"),
+                          TLArg(getXrPath(createInfo->subactionPath).data(), "SubactionPath"),
                           TLArg(xr::ToString(createInfo->poseInActionSpace).c_str(), "PoseInActionSpace"));
 
         if (!m_sessionCreated || session != (XrSession)1) {
@@ -190,6 +190,8 @@ namespace virtualdesktop_openxr {
 
     // https://www.khronos.org/registry/OpenXR/specs/1.0/html/xrspec.html#xrLocateSpace
     XrResult OpenXrRuntime::xrLocateSpace(XrSpace space, XrSpace baseSpace, XrTime time, XrSpaceLocation* location) {
+        auto timeline = m_timeline.scope(TimelineEvent::LocateSpace);
+
         if (location->type != XR_TYPE_SPACE_LOCATION) {
             return XR_ERROR_VALIDATION_FAILURE;
         }
@@ -248,6 +250,9 @@ namespace virtualdesktop_openxr {
                               TLArg(xr::ToString(velocity->linearVelocity).c_str(), "LinearVelocity"));
         }
 
+        timeline.setArgs(time, (uint32_t)location->locationFlags);
+        timeline.setSucceeded();
+
         return XR_SUCCESS;
     }
 
@@ -426,14 +431,13 @@ namespace virtualdesktop_openxr {
         pose = Pose::Multiply(spaceToVirtual, Pose::Invert(baseSpaceToVirtual));
         if (velocity) {
             velocity->velocityFlags = spaceToVirtualVelocity.velocityFlags & baseSpaceToVirtualVelocity.velocityFlags;
+            MakeVelocityRelative(
+                spaceToVirtual, spaceToVirtualVelocity, baseSpaceToVirtual, baseSpaceToVirtualVelocity);
             if (velocity->velocityFlags & XR_SPACE_VELOCITY_ANGULAR_VALID_BIT) {
-                velocity->angularVelocity =
-                    spaceToVirtualVelocity.angularVelocity - baseSpaceToVirtualVelocity.angularVelocity;
+                velocity->angularVelocity = spaceToVirtualVelocity.angularVelocity;
             }
             if (velocity->velocityFlags & XR_SPACE_VELOCITY_LINEAR_VALID_BIT) {
-                // TODO: Does not account for centripetral forces.
-                velocity->linearVelocity =
-                    spaceToVirtualVelocity.linearVelocity - baseSpaceToVirtualVelocity.linearVelocity;
+                velocity->linearVelocity = spaceToVirtualVelocity.linearVelocity;
             }
         }
 
@@ -460,9 +464,10 @@ namespace virtualdesktop_openxr {
             result = getHmdPose(time, pose, velocity);
         } else if (xrSpace.referenceType == XR_REFERENCE_SPACE_TYPE_LOCAL) {
             // LOCAL space is the origin at eye level.
-            if (ovr_GetTrackingOriginType(m_ovrSession) == ovrTrackingOrigin_FloorLevel && !ignoreFloorHeight) {
-                const float floorHeight = ovr_GetFloat(m_ovrSession, OVR_KEY_EYE_HEIGHT, OVR_DEFAULT_EYE_HEIGHT);
-                TraceLoggingWrite(g_traceProvider, "OVR_GetConfig", TLArg(floorHeight, "EyeHeight"));
+            ovrTrackingOrigin originType;
+            float floorHeight;
+            getTrackingOrigin(time, originType, floorHeight);
+            if (originType == ovrTrackingOrigin_FloorLevel && !ignoreFloorHeight) {
                 if (std::abs(floorHeight) < FLT_EPSILON) {
                     // Virtual Desktop Stage Tracking mode.
                     if (!m_lastKnownFloorHeight) {
@@ -488,11 +493,12 @@ namespace virtualdesktop_openxr {
             }
         } else if (xrSpace.referenceType == XR_REFERENCE_SPACE_TYPE_STAGE) {
             // STAGE space is the origin at floor level.
-            if (ovr_GetTrackingOriginType(m_ovrSession) == ovrTrackingOrigin_FloorLevel || ignoreFloorHeight) {
+            ovrTrackingOrigin originType;
+            float floorHeight;
+            getTrackingOrigin(time, originType, floorHeight);
+            if (originType == ovrTrackingOrigin_FloorLevel || ignoreFloorHeight) {
                 pose = Pose::Identity();
             } else {
-                const float floorHeight = ovr_GetFloat(m_ovrSession, OVR_KEY_EYE_HEIGHT, OVR_DEFAULT_EYE_HEIGHT);
-                TraceLoggingWrite(g_traceProvider, "OVR_GetConfig", TLArg(floorHeight, "EyeHeight"));
                 pose = Pose::Translation({0, -floorHeight, 0});
             }
             result = (XR_SPACE_LOCATION_ORIENTATION_VALID_BIT | XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT |
@@ -504,7 +510,7 @@ namespace virtualdesktop_openxr {
             // Action spaces for motion controllers.
             Action& xrAction = *(Action*)xrSpace.action;
 
-            const std::string& subActionPath = getXrPath(xrSpace.subActionPath);
+            const std::string_view subActionPath = getXrPath(xrSpace.subActionPath);
             for (const auto& source : xrAction.actionSources) {
                 if (!startsWith(source.first, subActionPath)) {
                     continue;
@@ -536,15 +542,22 @@ namespace virtualdesktop_openxr {
                         result = getControllerPose(side, time, pose, velocity);
 
                         // Apply the pose offsets.
+                        const XrPosef* offset = nullptr;
                         if (isAimPose) {
                             // Try using the hand tracking first.
-                            if (!getPinchPose(side, pose, pose)) {
-                                pose = Pose::Multiply(m_controllerAimPose[side], pose);
+                            if (!getPinchPose(side, time, pose, pose)) {
+                                offset = &m_controllerAimPose[side];
                             }
                         } else if (isGripPose) {
-                            pose = Pose::Multiply(m_controllerGripPose[side], pose);
+                            offset = &m_controllerGripPose[side];
                         } else {
-                            pose = Pose::Multiply(m_controllerPalmPose[side], pose);
+                            offset = &m_controllerPalmPose[side];
+                        }
+                        if (offset) {
+                            if (velocity) {
+                                ApplyOffsetToVelocity(*offset, pose, *velocity);
+                            }
+                            pose = Pose::Multiply(*offset, pose);
                         }
 
                         // Per spec we must consistently pick one source. We pick the first one.
@@ -555,6 +568,9 @@ namespace virtualdesktop_openxr {
         }
 
         // Apply the offset transform.
+        if (velocity) {
+            ApplyOffsetToVelocity(xrSpace.poseInSpace, pose, *velocity);
+        }
         pose = Pose::Multiply(xrSpace.poseInSpace, pose);
 
         return result;
@@ -563,8 +579,7 @@ namespace virtualdesktop_openxr {
     XrSpaceLocationFlags OpenXrRuntime::getHmdPose(XrTime time, XrPosef& pose, XrSpaceVelocity* velocity) const {
         XrSpaceLocationFlags locationFlags = 0;
         ovrPoseStatef state{};
-        ovrTrackedDeviceType hmd = ovrTrackedDevice_HMD;
-        const auto result = ovr_GetDevicePoses(m_ovrSession, &hmd, 1, xrTimeToOvrTime(time), &state);
+        const auto result = getDevicePose(ovrTrackedDevice_HMD, time, state);
         if (result == ovrError_LostTracking) {
             TraceLoggingWrite(g_traceProvider, "OVR_HmdPoseNotTracking");
         } else {
@@ -608,8 +623,7 @@ namespace virtualdesktop_openxr {
     OpenXrRuntime::getControllerPose(int side, XrTime time, XrPosef& pose, XrSpaceVelocity* velocity) const {
         XrSpaceLocationFlags locationFlags = 0;
         ovrPoseStatef state{};
-        ovrTrackedDeviceType controller = side == 0 ? ovrTrackedDevice_LTouch : ovrTrackedDevice_RTouch;
-        const auto result = ovr_GetDevicePoses(m_ovrSession, &controller, 1, xrTimeToOvrTime(time), &state);
+        const auto result = getDevicePose(side == 0 ? ovrTrackedDevice_LTouch : ovrTrackedDevice_RTouch, time, state);
         if (result == ovrError_LostTracking) {
             TraceLoggingWrite(g_traceProvider, "OVR_HmdPoseNotTracking", TLArg(side == 0 ? "Left" : "Right", "Side"));
         } else {
@@ -677,4 +691,95 @@ namespace virtualdesktop_openxr {
                XR_SPACE_LOCATION_POSITION_VALID_BIT | XR_SPACE_LOCATION_POSITION_TRACKED_BIT;
     }
 
+    // Find the tracking snapshot for the requested time, or capture a new one. A single frame typically locates
+    // dozens of spaces at the same time, and we only want to query LibOVR once for all of them.
+    // Must be called with m_trackingSnapshotMutex held.
+    OpenXrRuntime::TrackingSnapshot& OpenXrRuntime::getTrackingSnapshot(XrTime time) const {
+        for (auto& snapshot : m_trackingSnapshotCache.snapshots) {
+            if (snapshot.isValid && std::abs(snapshot.time - time) <= TrackingSnapshotCache::k_timeTolerance) {
+                return snapshot;
+            }
+        }
+
+        TrackingSnapshot& snapshot = m_trackingSnapshotCache.snapshots[m_trackingSnapshotCache.nextSnapshot];
+        m_trackingSnapshotCache.nextSnapshot =
+            (m_trackingSnapshotCache.nextSnapshot + 1) % (uint32_t)std::size(m_trackingSnapshotCache.snapshots);
+
+        snapshot = {};
+        snapshot.isValid = true;
+        snapshot.time = time;
+        snapshot.originType = ovr_GetTrackingOriginType(m_ovrSession);
+        snapshot.eyeHeight = ovr_GetFloat(m_ovrSession, OVR_KEY_EYE_HEIGHT, OVR_DEFAULT_EYE_HEIGHT);
+
+        // Query all devices at once. The result of a batched query is qualified (eg: ovrSuccess_DeviceUnavailable)
+        // as soon as one device is not tracked, so we use the per-device status flags to tell which one.
+        const double ovrTime = xrTimeToOvrTime(time);
+        ovrTrackedDeviceType devices[] = {ovrTrackedDevice_HMD, ovrTrackedDevice_LTouch, ovrTrackedDevice_RTouch};
+        static_assert(std::size(devices) == std::size(snapshot.devicePose));
+        const auto result =
+            ovr_GetDevicePoses(m_ovrSession, devices, (int)std::size(devices), ovrTime, snapshot.devicePose);
+        if (result == ovrSuccess) {
+            for (uint32_t i = 0; i < std::size(devices); i++) {
+                snapshot.hasDevicePose[i] = true;
+                snapshot.devicePoseResult[i] = result;
+            }
+        } else if (OVR_SUCCESS(result)) {
+            const ovrTrackingState state = ovr_GetTrackingState(m_ovrSession, ovrTime, ovrFalse);
+
+            // An untracked HMD has its own error codes (eg: ovrError_LostTracking), so let the per-device query
+            // report it.
+            if (state.StatusFlags & ovrStatus_OrientationTracked) {
+                snapshot.hasDevicePose[0] = true;
+                snapshot.devicePoseResult[0] = ovrSuccess;
+            }
+            for (uint32_t side = 0; side < 2; side++) {
+                snapshot.hasDevicePose[1 + side] = true;
+                snapshot.devicePoseResult[1 + side] = (state.HandStatusFlags[side] & ovrStatus_OrientationTracked)
+                                                          ? ovrSuccess
+                                                          : ovrSuccess_DeviceUnavailable;
+            }
+        }
+
+        TraceLoggingWrite(g_traceProvider,
+                          "TrackingSnapshot",
+                          TLArg(time, "Time"),
+                          TLArg((int)snapshot.originType, "OriginType"),
+                          TLArg(snapshot.eyeHeight, "EyeHeight"),
+                          TLArg(result, "DevicePosesResult"));
+
+        return snapshot;
+    }
+
+    ovrResult OpenXrRuntime::getDevicePose(ovrTrackedDeviceType device, XrTime time, ovrPoseStatef& state) const {
+        const uint32_t index = device == ovrTrackedDevice_HMD ? 0 : device == ovrTrackedDevice_LTouch ? 1 : 2;
+
+        std::unique_lock lock(m_trackingSnapshotMutex);
+
+        TrackingSnapshot& snapshot = getTrackingSnapshot(time);
+        if (!snapshot.hasDevicePose[index]) {
+            snapshot.devicePoseResult[index] =
+                ovr_GetDevicePoses(m_ovrSession, &device, 1, xrTimeToOvrTime(time), &snapshot.devicePose[index]);
+            snapshot.hasDevicePose[index] = true;
+        }
+
+        state = snapshot.devicePose[index];
+        return snapshot.devicePoseResult[index];
+    }
+
+    void OpenXrRuntime::getTrackingOrigin(XrTime time, ovrTrackingOrigin& originType, float& eyeHeight) const {
+        std::unique_lock lock(m_trackingSnapshotMutex);
+
+        const TrackingSnapshot& snapshot = getTrackingSnapshot(time);
+        originType = snapshot.originType;
+        eyeHeight = snapshot.eyeHeight;
+    }
+
+    void OpenXrRuntime::invalidateTrackingSnapshots() {
+        std::unique_lock lock(m_trackingSnapshotMutex);
+
+        for (auto& snapshot : m_trackingSnapshotCache.snapshots) {
+            snapshot.isValid = false;
+        }
+    }
+
 } // namespace virtualdesktop_openxr
@@ -367,6 +367,35 @@ namespace virtualdesktop_openxr {
             desc.BindFlags |= ovrTextureBind_DX_UnorderedAccess;
         }
 
+        // Recycle a compatible swapchain previously destroyed by the application, once the GPU is done with it.
+        {
+            std::unique_lock lock(m_swapchainsMutex);
+
+            releaseSwapchains(m_swapchainPool.evictExpired(ovr_GetTimeInSeconds()));
+            releaseCompletedSwapchains();
+
+            const auto recycled = m_swapchainPool.isEnabled()
+                                      ? m_swapchainPool.take(SwapchainPoolKey(*createInfo),
+                                                             m_ovrSubmissionFence->GetCompletedValue())
+                                      : std::nullopt;
+            if (recycled) {
+                Swapchain& xrSwapchain = *recycled.value();
+                xrSwapchain.xrDesc = *createInfo;
+
+                *swapchain = (XrSwapchain)&xrSwapchain;
+                m_swapchains.insert(*swapchain);
+
+                TraceLoggingWrite(g_traceProvider,
+                                  "xrCreateSwapchain",
+                                  TLXArg(*swapchain, "Swapchain"),
+                                  TLArg(true, "Recycled"),
+                                  TLArg(m_swapchainPool.getHits(), "PoolHits"),
+                                  TLArg(m_swapchainPool.getMisses(), "PoolMisses"));
+
+                return XR_SUCCESS;
+            }
+        }
+
         ovrTextureSwapChain ovrSwapchain{};
         int length = 0;
         // If and only if the swapchain images are directly usable by LibOVR, we create an OVR swapchain. Otherwise, we
@@ -421,6 +450,109 @@ namespace virtualdesktop_openxr {
             return XR_ERROR_HANDLE_INVALID;
         }
 
+        Swapchain& xrSwapchain = *(Swapchain*)swapchain;
+        m_swapchains.erase(swapchain);
+
+        // Rather than freeing the swapchain, keep it for a future xrCreateSwapchain() with the same parameters.
+        std::vector<Swapchain*> swapchainsToFree;
+        if (m_swapchainPool.isEnabled()) {
+            swapchainsToFree = parkSwapchain(xrSwapchain);
+        } else {
+            swapchainsToFree.push_back(&xrSwapchain);
+        }
+        for (Swapchain* expired : m_swapchainPool.evictExpired(ovr_GetTimeInSeconds())) {
+            swapchainsToFree.push_back(expired);
+        }
+        releaseSwapchains(swapchainsToFree);
+        releaseCompletedSwapchains();
+
+        return XR_SUCCESS;
+    }
+
+    // Reset the state of a destroyed swapchain and place it in the pool. Returns the swapchains evicted from the pool.
+    std::vector<OpenXrRuntime::Swapchain*> OpenXrRuntime::parkSwapchain(Swapchain& xrSwapchain) {
+        xrSwapchain.acquiredIndices.clear();
+        xrSwapchain.lastWaitedIndex = -1;
+        xrSwapchain.lastReleasedIndex = -1;
+        xrSwapchain.frozen = false;
+        for (auto& slice : xrSwapchain.resolvedSlices) {
+            slice.lastPreprocessed.reset();
+        }
+
+        // The images might still be used by the GPU, and they cannot be handed out again until then.
+        const uint64_t fenceValue = signalReleaseFence();
+
+        const SwapchainPoolKey key(xrSwapchain.xrDesc);
+        const uint64_t size = getSwapchainMemorySize(xrSwapchain);
+        TraceLoggingWrite(g_traceProvider,
+                          "SwapchainPool_Park",
+                          TLPArg(&xrSwapchain, "Swapchain"),
+                          TLArg(size, "Size"),
+                          TLArg(fenceValue, "FenceValue"));
+
+        return m_swapchainPool.park(key, &xrSwapchain, size, fenceValue, ovr_GetTimeInSeconds());
+    }
+
+    // Signal a fence value that completes once both the app queue and the submission device are done with all the
+    // work submitted so far. This does not wait for the GPU.
+    uint64_t OpenXrRuntime::signalReleaseFence() {
+        if (m_useAsyncSubmission && !m_needStartAsyncSubmissionThread) {
+            waitForAsyncSubmissionIdle();
+        }
+
+        const uint64_t appFenceValue = m_fenceValue;
+        if (isD3D12Session()) {
+            signalD3D12CommandQueue();
+        } else if (isVulkanSession()) {
+            signalVulkanCommandQueue();
+        } else if (isOpenGLSession()) {
+            signalOpenGLContext();
+        } else {
+            signalD3D11Context();
+        }
+        if (m_fenceValue != appFenceValue) {
+            CHECK_HRCMD(m_ovrSubmissionContext->Wait(m_ovrSubmissionFence.Get(), m_fenceValue));
+        }
+
+        m_fenceValue++;
+        CHECK_HRCMD(m_ovrSubmissionContext->Signal(m_ovrSubmissionFence.Get(), m_fenceValue));
+        m_ovrSubmissionContext->Flush();
+
+        return m_fenceValue;
+    }
+
+    // Queue swapchains that are no longer used by the application nor pooled, to be freed once the GPU is done.
+    void OpenXrRuntime::releaseSwapchains(const std::vector<Swapchain*>& swapchains) {
+        if (swapchains.empty()) {
+            return;
+        }
+
+        const uint64_t fenceValue = signalReleaseFence();
+        for (Swapchain* swapchain : swapchains) {
+            TraceLoggingWrite(g_traceProvider,
+                              "SwapchainRelease_Queue",
+                              TLPArg(swapchain, "Swapchain"),
+                              TLArg(fenceValue, "FenceValue"));
+            m_swapchainReleaseQueue.push(swapchain, fenceValue);
+        }
+    }
+
+    // Free the queued swapchains whose fence has completed.
+    void OpenXrRuntime::releaseCompletedSwapchains() {
+        if (m_swapchainReleaseQueue.empty()) {
+            return;
+        }
+
+        m_swapchainReleaseQueue.releaseCompleted(m_ovrSubmissionFence->GetCompletedValue(),
+                                                 [&](Swapchain* swapchain) { freeSwapchain(*swapchain); });
+    }
+
+    // Free all the queued swapchains, waiting for the GPU to be idle first.
+    void OpenXrRuntime::drainSwapchainReleases() {
+        if (m_swapchainReleaseQueue.empty()) {
+            return;
+        }
+
         // Make sure there are no pending operations.
         if (isD3D12Session()) {
             flushD3D12CommandQueue();
@@ -436,7 +568,14 @@ namespace virtualdesktop_openxr {
         }
         flushSubmissionContext();
 
-        Swapchain& xrSwapchain = *(Swapchain*)swapchain;
+        m_swapchainReleaseQueue.drain([&](Swapchain* swapchain) { freeSwapchain(*swapchain); });
+    }
+
+    // Free the resources of a swapchain. The GPU must be done with it.
+    void OpenXrRuntime::freeSwapchain(Swapchain& xrSwapchain) {
+        TraceLoggingWrite(g_traceProvider, "SwapchainPool_Free", TLPArg(&xrSwapchain, "Swapchain"));
+
+        evictSwapchainViews(xrSwapchain);
 
         if (!xrSwapchain.resolvedSlices.empty() && xrSwapchain.appSwapchain.ovrSwapchain &&
             xrSwapchain.resolvedSlices[0].ovrSwapchain != xrSwapchain.appSwapchain.ovrSwapchain) {
@@ -454,9 +593,23 @@ namespace virtualdesktop_openxr {
         cleanupSwapchainImagesOpenGL(xrSwapchain);
 
         delete &xrSwapchain;
-        m_swapchains.erase(swapchain);
+    }
 
-        return XR_SUCCESS;
+    // Estimate the video memory held by a swapchain, including the swapchains we created for resolving slices.
+    uint64_t OpenXrRuntime::getSwapchainMemorySize(const Swapchain& xrSwapchain) const {
+        const auto& desc = xrSwapchain.ovrDesc;
+        uint64_t imageSize = (uint64_t)desc.Width * desc.Height * ovrGetBytePerPixels(desc.Format);
+        if (desc.MipLevels > 1) {
+            imageSize = imageSize * 4 / 3;
+        }
+
+        uint64_t size = imageSize * desc.ArraySize * desc.SampleCount * xrSwapchain.ovrSwapchainLength;
+        for (const auto& slice : xrSwapchain.resolvedSlices) {
+            if (slice.ovrSwapchain && slice.ovrSwapchain != xrSwapchain.appSwapchain.ovrSwapchain) {
+                size += imageSize * xrSwapchain.ovrSwapchainLength;
+            }
+        }
+        return size;
     }
 
     // https://www.khronos.org/registry/OpenXR/specs/1.0/html/xrspec.html#xrEnumerateSwapchainImages
@@ -579,6 +732,8 @@ namespace virtualdesktop_openxr {
     // https://www.khronos.org/registry/OpenXR/specs/1.0/html/xrspec.html#xrReleaseSwapchainImage
     XrResult OpenXrRuntime::xrReleaseSwapchainImage(XrSwapchain swapchain,
                                                     const XrSwapchainImageReleaseInfo* releaseInfo) {
+        auto timeline = m_timeline.scope(TimelineEvent::ReleaseSwapchainImage);
+
         if (releaseInfo && releaseInfo->type != XR_TYPE_SWAPCHAIN_IMAGE_RELEASE_INFO) {
             return XR_ERROR_VALIDATION_FAILURE;
         }
@@ -600,10 +755,14 @@ namespace virtualdesktop_openxr {
 
         // Update the state of the swapchain.
         // We never commit images here: this is because LibOVR producer/consumer model works much differently than
-        // OpenXR. We will perform swapchain commits in preprocessSwapchainImage().
+        // OpenXR. We will schedule swapchain commits in preprocessSwapchainImage().
         xrSwapchain.lastReleasedIndex = xrSwapchain.lastWaitedIndex;
         xrSwapchain.lastWaitedIndex = -1;
         xrSwapchain.acquiredIndices.pop_front();
+        xrSwapchain.releaseCount++;
+
+        timeline.setArgs((uint64_t)swapchain, xrSwapchain.lastReleasedIndex);
+        timeline.setSucceeded();
 
         return XR_SUCCESS;
     }
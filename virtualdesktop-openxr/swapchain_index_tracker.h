@@ -0,0 +1,100 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "pch.h"
+
+namespace virtualdesktop_openxr::utils {
+
+    // A model of the image ring of an OVR swapchain, so that the commits needed to present an image can be counted
+    // ahead of time instead of being discovered by polling the current index after each commit.
+    // LibOVR hands out the images in order: the current index is the image that the next commit will present, and
+    // each commit advances it by one. Commits are first scheduled (pending), then issued as a batch, and the resulting
+    // current index is checked once to detect any desync with the compositor.
+    class SwapchainIndexTracker {
+      public:
+        bool isSynchronized() const {
+            return m_length > 0;
+        }
+
+        // Start tracking from the current index reported by LibOVR. Discards any pending commits.
+        void synchronize(int length, int currentIndex) {
+            m_length = length;
+            m_currentIndex = currentIndex;
+            m_pendingCommits = 0;
+        }
+
+        // Forget the state of the ring, for example after an error left the commits in an unknown state.
+        void invalidate() {
+            m_length = 0;
+            m_pendingCommits = 0;
+        }
+
+        // The image that the next commit will present, once all pending commits are issued.
+        int currentIndex() const {
+            return m_currentIndex;
+        }
+
+        // The most recently committed image, once all pending commits are issued.
+        int committedIndex() const {
+            return (m_currentIndex + m_length - 1) % m_length;
+        }
+
+        // The number of commits needed for the image to become the most recently committed one.
+        int commitsToPresent(int index) const {
+            return (index - committedIndex() + m_length) % m_length;
+        }
+
+        // Schedule the commits needed to present the image. Returns the number of commits scheduled.
+        int present(int index) {
+            const int commits = commitsToPresent(index);
+            m_currentIndex = (index + 1) % m_length;
+            m_pendingCommits += commits;
+            return commits;
+        }
+
+        // Retrieve (and clear) the number of commits to issue to LibOVR.
+        int takePendingCommits() {
+            const int commits = m_pendingCommits;
+            m_pendingCommits = 0;
+            return commits;
+        }
+
+        // Compare the current index reported by LibOVR after issuing the commits against the model, and resynchronize
+        // upon mismatch. Returns false upon desync.
+        bool verify(int currentIndex) {
+            if (currentIndex == m_currentIndex) {
+                return true;
+            }
+
+            synchronize(m_length, currentIndex);
+            return false;
+        }
+
+      private:
+        int m_length{0};
+        int m_currentIndex{0};
+        int m_pendingCommits{0};
+    };
+
+} // namespace virtualdesktop_openxr::utils
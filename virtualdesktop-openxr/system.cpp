@@ -544,6 +544,7 @@ namespace virtualdesktop_openxr {
                 ovr_GetRenderDesc(m_ovrSession, ovrEye_Right, m_cachedHmdInfo.DefaultEyeFov[ovrEye_Right]);
             m_cachedProjectionResolution =
                 ovr_GetFovTextureSize(m_ovrSession, ovrEye_Left, m_cachedEyeInfo[xr::StereoView::Left].Fov, 1.f);
+            invalidateVisibilityMasks();
 
             for (uint32_t i = 0; i < xr::StereoView::Count; i++) {
                 m_cachedEyeFov[i].angleDown = -atan(m_cachedEyeInfo[i].Fov.DownTan);
@@ -602,11 +603,8 @@ namespace virtualdesktop_openxr {
                 break;
             }
 
-            // Cache the new state.
-            {
-                std::unique_lock lock(m_bodyStateMutex);
-                m_cachedBodyState = *m_bodyState;
-            }
+            // Record the new state. Virtual Desktop does not timestamp the state, so we use the time of arrival.
+            m_bodyStateHistory.push(ovr_GetTimeInSeconds(), *m_bodyState);
 
             // Avoid spurious wakeup when the event was not reset quickly-enough.
             std::this_thread::sleep_for(std::chrono::milliseconds(5));
@@ -615,4 +613,36 @@ namespace virtualdesktop_openxr {
         TraceLoggingWriteStop(local, "BodyStateWatcherThread");
     }
 
+    // Retrieve the body state at the requested time.
+    bool OpenXrRuntime::getBodyState(XrTime time, BodyTracking::BodyStateV2& state) const {
+        if (!m_bodyState) {
+            return false;
+        }
+
+        return m_bodyStateHistory.sample(xrTimeToOvrTime(time), m_bodyStatePrediction, state);
+    }
+
+    // Retrieve the time that a signal returned by getBodyState() actually represents, since it is only extrapolated up
+    // to maxPrediction past the most recent state.
+    XrTime OpenXrRuntime::getBodyStateSampleTime(XrTime time, double maxPrediction) const {
+        const auto newestTime = m_bodyStateHistory.newestTime();
+        if (!newestTime) {
+            return time;
+        }
+        if (m_bodyStatePrediction.mode != BodyStateHistory::PredictionMode::Extrapolate) {
+            maxPrediction = 0.0;
+        }
+
+        return std::min(time, ovrTimeToXrTime(newestTime.value() + maxPrediction));
+    }
+
+    // Retrieve the most recent body state.
+    bool OpenXrRuntime::getLatestBodyState(BodyTracking::BodyStateV2& state) const {
+        if (!m_bodyState) {
+            return false;
+        }
+
+        return m_bodyStateHistory.latest(state);
+    }
+
 } // namespace virtualdesktop_openxr
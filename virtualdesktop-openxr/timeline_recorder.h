@@ -0,0 +1,186 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "pch.h"
+
+namespace virtualdesktop_openxr::utils {
+
+    // The frame timeline file format. All fields are little-endian. The file is a TimelineHeader followed by
+    // TimelineRecord entries until the end of the file. Any change to the layout must bump k_timelineVersion, and
+    // scripts/Analyze-FrameTimeline.py must be updated accordingly.
+    constexpr char k_timelineMagic[8] = {'V', 'D', 'X', 'R', 'T', 'L', '\0', '\0'};
+    constexpr uint32_t k_timelineVersion = 1;
+
+    enum class TimelineEvent : uint16_t {
+        WaitFrame = 1,        // arg0: predicted display time, arg1: frame ID.
+        BeginFrame,           // arg0: frame ID, arg1: 1 if the previous frame was discarded.
+        EndFrame,             // arg0: display time, arg1: layer count.
+        SyncActions,          // arg0: unused, arg1: number of active action sets.
+        LocateSpace,          // arg0: time, arg1: location flags.
+        ReleaseSwapchainImage // arg0: swapchain handle, arg1: image index.
+    };
+
+    struct TimelineHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t recordSize;
+        int64_t qpcFrequency;
+    };
+
+    // One call to an API, from entry to exit. Times are QueryPerformanceCounter() values.
+    struct TimelineRecord {
+        int64_t startTime;
+        int64_t endTime;
+        uint64_t arg0;
+        uint32_t arg1;
+        uint32_t threadId;
+        TimelineEvent event;
+        uint16_t result; // 0 upon success, 1 upon failure.
+        uint32_t reserved;
+    };
+    static_assert(sizeof(TimelineHeader) == 24);
+    static_assert(sizeof(TimelineRecord) == 40);
+
+    // Record API calls to a file. Recording is meant for diagnostics: records are batched in memory, and the batch
+    // is written out by whichever thread fills it.
+    class TimelineRecorder {
+      public:
+        static constexpr size_t k_batchSize = 4096;
+
+        // Record an API call upon leaving the scope.
+        class Scope {
+          public:
+            Scope(TimelineRecorder* recorder, TimelineEvent event) : m_recorder(recorder) {
+                if (m_recorder) {
+                    m_record.event = event;
+                    m_record.threadId = GetCurrentThreadId();
+                    m_record.startTime = now();
+                }
+            }
+
+            ~Scope() {
+                if (m_recorder) {
+                    m_record.endTime = now();
+                    m_record.result = m_succeeded ? 0 : 1;
+                    m_recorder->record(m_record);
+                }
+            }
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+            void setArgs(uint64_t arg0, uint32_t arg1) {
+                m_record.arg0 = arg0;
+                m_record.arg1 = arg1;
+            }
+
+            void setSucceeded() {
+                m_succeeded = true;
+            }
+
+          private:
+            TimelineRecorder* const m_recorder;
+            TimelineRecord m_record{};
+            bool m_succeeded{false};
+        };
+
+        ~TimelineRecorder() {
+            stop();
+        }
+
+        bool start(const std::filesystem::path& path) {
+            std::unique_lock lock(m_mutex);
+
+            if (m_file.is_open()) {
+                return true;
+            }
+
+            m_file.open(path, std::ios_base::binary | std::ios_base::trunc);
+            if (!m_file.is_open()) {
+                return false;
+            }
+
+            LARGE_INTEGER frequency;
+            QueryPerformanceFrequency(&frequency);
+            TimelineHeader header{};
+            std::copy_n(k_timelineMagic, sizeof(header.magic), header.magic);
+            header.version = k_timelineVersion;
+            header.recordSize = sizeof(TimelineRecord);
+            header.qpcFrequency = frequency.QuadPart;
+            m_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+            m_batch.reserve(k_batchSize);
+            m_isRecording = true;
+            return true;
+        }
+
+        void stop() {
+            std::unique_lock lock(m_mutex);
+
+            m_isRecording = false;
+            if (m_file.is_open()) {
+                flush();
+                m_file.close();
+            }
+        }
+
+        // Returns a scope that does nothing when not recording.
+        Scope scope(TimelineEvent event) {
+            return Scope(m_isRecording ? this : nullptr, event);
+        }
+
+      private:
+        static int64_t now() {
+            LARGE_INTEGER time;
+            QueryPerformanceCounter(&time);
+            return time.QuadPart;
+        }
+
+        void record(const TimelineRecord& record) {
+            std::unique_lock lock(m_mutex);
+
+            // We might have stopped while the call was in progress.
+            if (!m_file.is_open()) {
+                return;
+            }
+
+            m_batch.push_back(record);
+            if (m_batch.size() == k_batchSize) {
+                flush();
+            }
+        }
+
+        void flush() {
+            m_file.write(reinterpret_cast<const char*>(m_batch.data()), m_batch.size() * sizeof(TimelineRecord));
+            m_file.flush();
+            m_batch.clear();
+        }
+
+        std::mutex m_mutex;
+        std::atomic<bool> m_isRecording{false};
+        std::ofstream m_file;
+        std::vector<TimelineRecord> m_batch;
+    };
+
+} // namespace virtualdesktop_openxr::utils
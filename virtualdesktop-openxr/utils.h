@@ -659,6 +659,18 @@ namespace virtualdesktop_openxr::utils {
         }
     }
 
+    static size_t ovrGetBytePerPixels(ovrTextureFormat format) {
+        switch (format) {
+        case OVR_FORMAT_D16_UNORM:
+            return 2;
+        case OVR_FORMAT_R16G16B16A16_FLOAT:
+        case OVR_FORMAT_D32_FLOAT_S8X24_UINT:
+            return 8;
+        default:
+            return 4;
+        }
+    }
+
     static inline bool isValidSwapchainRect(ovrTextureSwapChainDesc desc, const XrRect2Di& rect) {
         if (rect.offset.x < 0 || rect.offset.y < 0 || rect.extent.width <= 0 || rect.extent.height <= 0) {
             return false;
@@ -683,11 +695,11 @@ namespace virtualdesktop_openxr::utils {
         }
     }
 
-    static inline bool startsWith(const std::string& str, const std::string& substr) {
+    static inline bool startsWith(std::string_view str, std::string_view substr) {
         return str.find(substr) == 0;
     }
 
-    static inline bool endsWith(const std::string& str, const std::string& substr) {
+    static inline bool endsWith(std::string_view str, std::string_view substr) {
         const auto pos = str.find(substr);
         return pos != std::string::npos && pos == str.size() - substr.size();
     }
@@ -0,0 +1,147 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "pch.h"
+
+namespace virtualdesktop_openxr::utils {
+
+    // A cache with a bounded number of entries, evicting the least recently used one first.
+    template <typename Key, typename Value, typename Hash = std::hash<Key>>
+    class LruCache {
+      public:
+        explicit LruCache(size_t capacity = 256) : m_capacity(std::max(capacity, size_t{1})) {
+        }
+
+        void setCapacity(size_t capacity) {
+            m_capacity = std::max(capacity, size_t{1});
+            trim();
+        }
+
+        // Retrieve the value for the key, or create it with the factory upon miss. The value is returned by copy, so
+        // that it stays valid even if it is evicted by a later lookup.
+        template <typename Factory>
+        Value get(const Key& key, Factory&& factory) {
+            const auto it = m_index.find(key);
+            if (it != m_index.end()) {
+                m_hits++;
+                m_entries.splice(m_entries.begin(), m_entries, it->second);
+                return it->second->second;
+            }
+
+            m_misses++;
+            Value value = factory();
+            m_entries.emplace_front(key, value);
+            m_index.emplace(key, m_entries.begin());
+            trim();
+            return value;
+        }
+
+        // Drop all the entries matching the predicate, for example when the underlying resources are destroyed.
+        template <typename Predicate>
+        void evictIf(Predicate&& predicate) {
+            for (auto it = m_entries.begin(); it != m_entries.end();) {
+                if (predicate(it->first)) {
+                    m_index.erase(it->first);
+                    it = m_entries.erase(it);
+                } else {
+                    it++;
+                }
+            }
+        }
+
+        void clear() {
+            m_index.clear();
+            m_entries.clear();
+        }
+
+        size_t size() const {
+            return m_entries.size();
+        }
+        uint64_t getHits() const {
+            return m_hits;
+        }
+        uint64_t getMisses() const {
+            return m_misses;
+        }
+        uint64_t getEvictions() const {
+            return m_evictions;
+        }
+
+      private:
+        void trim() {
+            while (m_entries.size() > m_capacity) {
+                m_index.erase(m_entries.back().first);
+                m_entries.pop_back();
+                m_evictions++;
+            }
+        }
+
+        size_t m_capacity;
+        std::list<std::pair<Key, Value>> m_entries;
+        std::unordered_map<Key, typename std::list<std::pair<Key, Value>>::iterator, Hash> m_index;
+
+        uint64_t m_hits{0};
+        uint64_t m_misses{0};
+        uint64_t m_evictions{0};
+    };
+
+    enum class ViewType : uint32_t { ShaderResource, UnorderedAccess, RenderTarget, DepthStencil };
+
+    // Identifies a view of a texture, independently of the graphics API.
+    struct ViewKey {
+        const void* resource;
+        ViewType type;
+        uint32_t dimension;
+        uint32_t format;
+        uint32_t mipSlice;
+        uint32_t firstArraySlice;
+        uint32_t arraySize;
+
+        bool operator==(const ViewKey& other) const {
+            return resource == other.resource && type == other.type && dimension == other.dimension &&
+                   format == other.format && mipSlice == other.mipSlice && firstArraySlice == other.firstArraySlice &&
+                   arraySize == other.arraySize;
+        }
+    };
+
+    struct ViewKeyHash {
+        size_t operator()(const ViewKey& key) const {
+            // FNV-1a over the fields.
+            uint64_t hash = 14695981039346656037ull;
+            const auto mix = [&](uint64_t value) {
+                hash ^= value;
+                hash *= 1099511628211ull;
+            };
+            mix((uintptr_t)key.resource);
+            mix((uint64_t)key.type);
+            mix(key.dimension);
+            mix(key.format);
+            mix(key.mipSlice);
+            mix(key.firstArraySlice);
+            mix(key.arraySize);
+            return (size_t)hash;
+        }
+    };
+
+} // namespace virtualdesktop_openxr::utils
@@ -70,62 +70,109 @@ namespace virtualdesktop_openxr {
             return XR_ERROR_VALIDATION_FAILURE;
         }
 
-        uint32_t indicesStride = 1;
-        ovrFovStencilDesc stencilDesc{};
+        uint32_t maskIndex = 0;
         switch (visibilityMaskType) {
         case XR_VISIBILITY_MASK_TYPE_HIDDEN_TRIANGLE_MESH_KHR:
-            stencilDesc.StencilType = ovrFovStencil_HiddenArea;
+            maskIndex = 0;
             break;
         case XR_VISIBILITY_MASK_TYPE_VISIBLE_TRIANGLE_MESH_KHR:
-            stencilDesc.StencilType = ovrFovStencil_VisibleArea;
+            maskIndex = 1;
             break;
         case XR_VISIBILITY_MASK_TYPE_LINE_LOOP_KHR:
-            stencilDesc.StencilType = ovrFovStencil_BorderLine;
-            indicesStride = 2;
+            maskIndex = 2;
             break;
         default:
             return XR_ERROR_VALIDATION_FAILURE;
         }
+
+        std::unique_lock lock(m_visibilityMaskMutex);
+
+        const VisibilityMask& mask = getVisibilityMask(viewIndex, maskIndex);
+        const uint32_t vertexCount = (uint32_t)mask.vertices.size();
+        const uint32_t indexCount = (uint32_t)mask.indices.size();
+
+        if (visibilityMask->vertexCapacityInput == 0) {
+            visibilityMask->vertexCountOutput = vertexCount;
+            visibilityMask->indexCountOutput = indexCount;
+        } else if (visibilityMask->vertices && visibilityMask->indices) {
+            if (visibilityMask->vertexCapacityInput < vertexCount || visibilityMask->indexCapacityInput < indexCount) {
+                return XR_ERROR_SIZE_INSUFFICIENT;
+            }
+
+            memcpy(visibilityMask->vertices, mask.vertices.data(), vertexCount * sizeof(XrVector2f));
+            memcpy(visibilityMask->indices, mask.indices.data(), indexCount * sizeof(uint32_t));
+
+            visibilityMask->vertexCountOutput = vertexCount;
+            visibilityMask->indexCountOutput = indexCount;
+        }
+
+        return XR_SUCCESS;
+    }
+
+    // Retrieve the mesh for a view and mask type. The mesh is only generated the first time, or when the eye
+    // parameters have changed since. Must be called with m_visibilityMaskMutex held.
+    const OpenXrRuntime::VisibilityMask& OpenXrRuntime::getVisibilityMask(uint32_t viewIndex, uint32_t maskIndex) {
+        VisibilityMask& mask = m_visibilityMasks[viewIndex][maskIndex];
+
+        const ovrFovPort& fov = m_cachedEyeInfo[viewIndex].Fov;
+        const ovrQuatf& hmdToEyeRotation = m_cachedEyeInfo[viewIndex].HmdToEyePose.Orientation;
+        if (mask.isValid && mask.hmdType == m_cachedHmdInfo.Type && !memcmp(&mask.fov, &fov, sizeof(fov)) &&
+            !memcmp(&mask.hmdToEyeRotation, &hmdToEyeRotation, sizeof(hmdToEyeRotation))) {
+            return mask;
+        }
+
+        static const ovrFovStencilType stencilTypes[] = {
+            ovrFovStencil_HiddenArea, ovrFovStencil_VisibleArea, ovrFovStencil_BorderLine};
+        // OVR returns the line loop as a list of segments. We only keep the first point of each segment.
+        const uint32_t indicesStride = stencilTypes[maskIndex] == ovrFovStencil_BorderLine ? 2 : 1;
+
+        ovrFovStencilDesc stencilDesc{};
+        stencilDesc.StencilType = stencilTypes[maskIndex];
         stencilDesc.Eye = !viewIndex ? ovrEye_Left : ovrEye_Right;
-        stencilDesc.FovPort = m_cachedEyeInfo[viewIndex].Fov;
-        stencilDesc.HmdToEyeRotation = m_cachedEyeInfo[viewIndex].HmdToEyePose.Orientation;
+        stencilDesc.FovPort = fov;
+        stencilDesc.HmdToEyeRotation = hmdToEyeRotation;
         ovrFovStencilMeshBuffer buffer{};
         CHECK_OVRCMD(ovr_GetFovStencil(m_ovrSession, &stencilDesc, &buffer));
 
         TraceLoggingWrite(g_traceProvider,
                           "OVR_FovStencil",
+                          TLArg(viewIndex, "ViewIndex"),
+                          TLArg((int)stencilDesc.StencilType, "StencilType"),
                           TLArg(buffer.UsedVertexCount, "VerticesCount"),
                           TLArg(buffer.UsedIndexCount, "IndicesCount"));
 
-        if (visibilityMask->vertexCapacityInput == 0) {
-            visibilityMask->vertexCountOutput = buffer.UsedVertexCount;
-            visibilityMask->indexCountOutput = buffer.UsedIndexCount / indicesStride;
-        } else if (visibilityMask->vertices && visibilityMask->indices) {
-            if ((int)visibilityMask->vertexCapacityInput < buffer.UsedVertexCount ||
-                (int)visibilityMask->indexCapacityInput < buffer.UsedIndexCount / indicesStride) {
-                return XR_ERROR_SIZE_INSUFFICIENT;
-            }
+        static_assert(sizeof(XrVector2f) == sizeof(ovrVector2f));
+        mask.vertices.resize(buffer.UsedVertexCount);
+        std::vector<uint16_t> indices(buffer.UsedIndexCount);
+        buffer.AllocVertexCount = buffer.UsedVertexCount;
+        buffer.VertexBuffer = reinterpret_cast<ovrVector2f*>(mask.vertices.data());
+        buffer.AllocIndexCount = buffer.UsedIndexCount;
+        buffer.IndexBuffer = indices.data();
+        CHECK_OVRCMD(ovr_GetFovStencil(m_ovrSession, &stencilDesc, &buffer));
 
-            static_assert(sizeof(XrVector2f) == sizeof(ovrVector2f));
-            buffer.AllocVertexCount = visibilityMask->vertexCapacityInput;
-            buffer.VertexBuffer = reinterpret_cast<ovrVector2f*>(visibilityMask->vertices);
-            buffer.AllocIndexCount = visibilityMask->indexCapacityInput;
-            std::vector<uint16_t> indices(buffer.UsedIndexCount);
-            buffer.IndexBuffer = indices.data();
-            CHECK_OVRCMD(ovr_GetFovStencil(m_ovrSession, &stencilDesc, &buffer));
+        convertSteamVRToOpenXRHiddenMesh(fov, mask.vertices.data(), buffer.UsedVertexCount);
 
-            convertSteamVRToOpenXRHiddenMesh(
-                m_cachedEyeInfo[viewIndex].Fov, visibilityMask->vertices, buffer.UsedVertexCount);
+        mask.indices.resize(buffer.UsedIndexCount / indicesStride);
+        for (uint32_t i = 0; i < mask.indices.size(); i++) {
+            mask.indices[i] = indices[i * indicesStride];
+        }
 
-            for (uint32_t i = 0; i < buffer.UsedIndexCount / indicesStride; i++) {
-                visibilityMask->indices[i] = buffer.IndexBuffer[i * indicesStride];
-            }
+        mask.fov = fov;
+        mask.hmdToEyeRotation = hmdToEyeRotation;
+        mask.hmdType = m_cachedHmdInfo.Type;
+        mask.isValid = true;
 
-            visibilityMask->vertexCountOutput = buffer.UsedVertexCount;
-            visibilityMask->indexCountOutput = buffer.UsedIndexCount / indicesStride;
-        }
+        return mask;
+    }
 
-        return XR_SUCCESS;
+    void OpenXrRuntime::invalidateVisibilityMasks() {
+        std::unique_lock lock(m_visibilityMaskMutex);
+
+        for (auto& view : m_visibilityMasks) {
+            for (auto& mask : view) {
+                mask.isValid = false;
+            }
+        }
     }
 
     void OpenXrRuntime::convertSteamVRToOpenXRHiddenMesh(const ovrFovPort& fov,
@@ -832,11 +832,9 @@ namespace virtualdesktop_openxr {
         }
     }
 
-    // Serialize commands from the Vulkan queue to the D3D11 context used by OVR.
-    void OpenXrRuntime::serializeVulkanFrame() {
+    // Signal the next fence value from the app queue, without waiting.
+    void OpenXrRuntime::signalVulkanCommandQueue() {
         m_fenceValue++;
-        TraceLoggingWrite(
-            g_traceProvider, "xrEndFrame_Sync", TLArg("Vulkan", "Api"), TLArg(m_fenceValue, "FenceValue"));
         VkTimelineSemaphoreSubmitInfo timelineInfo{VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO};
         timelineInfo.signalSemaphoreValueCount = 1;
         timelineInfo.pSignalSemaphoreValues = &m_fenceValue;
@@ -844,6 +842,13 @@ namespace virtualdesktop_openxr {
         submitInfo.signalSemaphoreCount = 1;
         submitInfo.pSignalSemaphores = &m_vkTimelineSemaphore;
         CHECK_VKCMD(m_vkDispatch.vkQueueSubmit(m_vkQueue, 1, &submitInfo, VK_NULL_HANDLE));
+    }
+
+    // Serialize commands from the Vulkan queue to the D3D11 context used by OVR.
+    void OpenXrRuntime::serializeVulkanFrame() {
+        signalVulkanCommandQueue();
+        TraceLoggingWrite(
+            g_traceProvider, "xrEndFrame_Sync", TLArg("Vulkan", "Api"), TLArg(m_fenceValue, "FenceValue"));
 
         waitOnSubmissionDevice();
     }